@@ -0,0 +1,282 @@
+// Copyright 2017 Eduardo Kohler
+
+#ifndef STRUCTURES_CLOCK_CACHE_H
+#define STRUCTURES_CLOCK_CACHE_H
+
+#include <atomic>         // std::atomic
+#include <cstdint>        // std::size_t
+#include <functional>     // std::hash
+#include <stdexcept>      // C++ Exceptions
+#include <unordered_map>  // std::unordered_map
+#include <utility>        // std::move
+
+#include "../listacircular/circular_list.h"
+#include "../memoria/node_pool.h"
+
+namespace structures {
+/**
+ * Implementation of a template CLOCK (second-chance) cache.
+ *
+ * Entries sit in a CircularList whose cursor is the clock hand, and a hash
+ * index maps each key to its entry. A hit only sets the entry's reference
+ * bit with a relaxed atomic store: the ring is left untouched, so get and
+ * contains never write shared structure and may run concurrently with
+ * each other (e.g. under the shared side of a reader-writer lock), while
+ * put, erase, evict and clear need exclusive access.
+ *
+ * To make room the hand sweeps the ring: a referenced entry has its bit
+ * cleared and is passed over, the first unreferenced one is evicted. New
+ * entries go right behind the hand, so they get a full sweep to be used.
+ * erase only unindexes its entry; the node is freed when the hand reaches
+ * it, which keeps erase O(1) on a singly linked ring.
+ */
+template <typename K, typename V, typename Hash = std::hash<K>>
+class ClockCache {
+ public:
+  explicit ClockCache(std::size_t max_entries);
+  ClockCache(const ClockCache&) = delete;
+  ClockCache& operator=(const ClockCache&) = delete;
+
+  void clear();
+  V* get(const K& key);
+  bool put(const K& key, const V& value);
+  bool put(const K& key, V&& value);
+  bool erase(const K& key);
+  bool evict();
+  bool contains(const K& key) const;
+  bool empty() const;
+  std::size_t size() const;
+  std::size_t max_entries() const;
+
+  std::size_t hits() const;
+  std::size_t misses() const;
+  std::size_t evictions() const;
+  double hit_ratio() const;
+  void reset_counters();
+
+ private:
+  struct Entry {
+    Entry(const K& key, V&& value) : key{key}, value{std::move(value)} {}
+
+    K key;
+    V value;
+    std::atomic<bool> referenced{false};
+    bool live{true};  // false once erased, until the hand frees it
+  };
+
+  using Ring = CircularList<Entry, PoolAllocator<Entry>>;
+
+  bool store(const K& key, V&& value);
+  bool sweep();
+
+  Ring ring_;  // the first entry is under the hand
+  std::unordered_map<K, Entry*, Hash> index_;
+  std::size_t max_entries_;
+  std::atomic<std::size_t> hits_{0u};
+  std::atomic<std::size_t> misses_{0u};
+  std::size_t evictions_{0u};
+};
+/**
+ * Constructor. Sets the budget.
+ * \param max_entries maximum number of entries (at least one).
+ */
+template <typename K, typename V, typename Hash>
+ClockCache<K, V, Hash>::ClockCache(std::size_t max_entries)
+    : max_entries_{max_entries} {
+  if (max_entries == 0) {
+    throw std::out_of_range("Parâmetro inválido");
+  }
+  index_.reserve(max_entries < 1024 ? max_entries : 1024);
+}
+/**
+ * Clears the cache. The counters are kept.
+ */
+template <typename K, typename V, typename Hash>
+void ClockCache<K, V, Hash>::clear() {
+  index_.clear();
+  ring_.clear();
+}
+/**
+ * Looks a key up, setting its reference bit on a hit. Safe to call
+ * concurrently with other get and contains calls.
+ * \return pointer to the value, valid until the cache changes, or nullptr
+ * on a miss.
+ */
+template <typename K, typename V, typename Hash>
+V* ClockCache<K, V, Hash>::get(const K& key) {
+  auto found = index_.find(key);
+  if (found == index_.end()) {
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    return nullptr;
+  }
+  hits_.fetch_add(1, std::memory_order_relaxed);
+  Entry* entry = found->second;
+  if (!entry->referenced.load(std::memory_order_relaxed)) {
+    entry->referenced.store(true, std::memory_order_relaxed);
+  }
+  return &entry->value;
+}
+/**
+ * Inserts or replaces the value of a key, evicting an entry first if the
+ * cache is full.
+ * \return whether the value is kept, as in LruCache::put; with no byte
+ * budget here, always true.
+ */
+template <typename K, typename V, typename Hash>
+bool ClockCache<K, V, Hash>::put(const K& key, const V& value) {
+  V copy(value);
+  return store(key, std::move(copy));
+}
+/**
+ * Same as put(key, value), moving the value in.
+ */
+template <typename K, typename V, typename Hash>
+bool ClockCache<K, V, Hash>::put(const K& key, V&& value) {
+  return store(key, std::move(value));
+}
+/**
+ * Removes a key in O(1). Its node is freed when the hand next reaches it.
+ * \return whether the key was cached.
+ */
+template <typename K, typename V, typename Hash>
+bool ClockCache<K, V, Hash>::erase(const K& key) {
+  auto found = index_.find(key);
+  if (found == index_.end()) {
+    return false;
+  }
+  found->second->live = false;
+  index_.erase(found);
+  return true;
+}
+/**
+ * Moves the hand until an entry is evicted.
+ * \return false if the cache is empty.
+ */
+template <typename K, typename V, typename Hash>
+bool ClockCache<K, V, Hash>::evict() {
+  while (!index_.empty()) {
+    if (sweep()) {
+      return true;
+    }
+  }
+  return false;
+}
+/**
+ * Checks if a key is cached, without setting its reference bit.
+ * \return boolean
+ */
+template <typename K, typename V, typename Hash>
+bool ClockCache<K, V, Hash>::contains(const K& key) const {
+  return index_.find(key) != index_.end();
+}
+/**
+ * Checks if the cache is empty.
+ * \return boolean
+ */
+template <typename K, typename V, typename Hash>
+bool ClockCache<K, V, Hash>::empty() const {
+  return index_.empty();
+}
+/**
+ * Returns the number of cached entries.
+ */
+template <typename K, typename V, typename Hash>
+std::size_t ClockCache<K, V, Hash>::size() const {
+  return index_.size();
+}
+/**
+ * Returns the entry budget.
+ */
+template <typename K, typename V, typename Hash>
+std::size_t ClockCache<K, V, Hash>::max_entries() const {
+  return max_entries_;
+}
+/**
+ * Returns how many get calls found their key.
+ */
+template <typename K, typename V, typename Hash>
+std::size_t ClockCache<K, V, Hash>::hits() const {
+  return hits_.load(std::memory_order_relaxed);
+}
+/**
+ * Returns how many get calls missed.
+ */
+template <typename K, typename V, typename Hash>
+std::size_t ClockCache<K, V, Hash>::misses() const {
+  return misses_.load(std::memory_order_relaxed);
+}
+/**
+ * Returns how many entries were evicted, by the budget or by evict().
+ */
+template <typename K, typename V, typename Hash>
+std::size_t ClockCache<K, V, Hash>::evictions() const {
+  return evictions_;
+}
+/**
+ * Returns the fraction of get calls that hit, or 0 before any call.
+ */
+template <typename K, typename V, typename Hash>
+double ClockCache<K, V, Hash>::hit_ratio() const {
+  std::size_t hits = this->hits();
+  std::size_t total = hits + misses();
+  return total == 0 ? 0.0 : static_cast<double>(hits) / total;
+}
+/**
+ * Sets the hit, miss and eviction counters back to zero.
+ */
+template <typename K, typename V, typename Hash>
+void ClockCache<K, V, Hash>::reset_counters() {
+  hits_.store(0, std::memory_order_relaxed);
+  misses_.store(0, std::memory_order_relaxed);
+  evictions_ = 0;
+}
+/**
+ * Replaces the value of a cached key, or makes room and links a new entry
+ * right behind the hand.
+ */
+template <typename K, typename V, typename Hash>
+bool ClockCache<K, V, Hash>::store(const K& key, V&& value) {
+  auto found = index_.find(key);
+  if (found != index_.end()) {
+    found->second->value = std::move(value);
+    found->second->referenced.store(true, std::memory_order_relaxed);
+    return true;
+  }
+  while (ring_.size() >= max_entries_) {
+    sweep();
+  }
+  auto slot = index_.emplace(key, nullptr).first;
+  try {
+    ring_.emplace_back(key, std::move(value));
+  } catch (...) {
+    index_.erase(slot);
+    throw;
+  }
+  slot->second = &ring_.back();
+  return true;
+}
+/**
+ * Moves the hand one entry: frees it if erased, gives it a second chance
+ * if referenced, evicts it otherwise.
+ * \return whether an entry was evicted.
+ */
+template <typename K, typename V, typename Hash>
+bool ClockCache<K, V, Hash>::sweep() {
+  Entry& entry = ring_.current();
+  if (!entry.live) {
+    ring_.erase(ring_.cbegin());
+    return false;
+  }
+  if (entry.referenced.load(std::memory_order_relaxed)) {
+    entry.referenced.store(false, std::memory_order_relaxed);
+    ring_.rotate();
+    return false;
+  }
+  index_.erase(entry.key);
+  ring_.erase(ring_.cbegin());
+  evictions_++;
+  return true;
+}
+}  // namespace structures
+
+#endif
@@ -0,0 +1,315 @@
+// Copyright 2017 Eduardo Kohler
+
+#ifndef STRUCTURES_LRU_CACHE_H
+#define STRUCTURES_LRU_CACHE_H
+
+#include <cstdint>        // std::size_t, SIZE_MAX
+#include <functional>     // std::hash
+#include <stdexcept>      // C++ Exceptions
+#include <unordered_map>  // std::unordered_map
+#include <utility>        // std::move
+
+#include "../lista2encadeada/doubly_linked_list.h"
+#include "../memoria/node_pool.h"
+
+namespace structures {
+/**
+ * Implementation of a template least-recently-used cache.
+ *
+ * Entries live in a DoublyLinkedList kept in recency order (most recent at
+ * the front), and a hash index maps each key to its node's iterator. A hit
+ * splices the node to the front without copying it, so get, put, touch,
+ * erase and evict are all O(1) on average.
+ *
+ * Two budgets bound the cache: a number of entries and a number of bytes.
+ * Each entry is charged the bytes given to put (by default the size of its
+ * key and value), and least recently used entries are evicted until both
+ * budgets hold. Hits, misses and evictions are counted.
+ */
+template <typename K, typename V, typename Hash = std::hash<K>>
+class LruCache {
+ public:
+  static const std::size_t UNLIMITED = SIZE_MAX;  // no byte budget
+
+  explicit LruCache(std::size_t max_entries,
+                    std::size_t max_bytes = UNLIMITED);
+  LruCache(const LruCache&) = delete;
+  LruCache(LruCache&& other) = default;
+  LruCache& operator=(const LruCache&) = delete;
+  LruCache& operator=(LruCache&& other) = default;
+
+  void clear();
+  V* get(const K& key);
+  bool put(const K& key, const V& value,
+           std::size_t bytes = sizeof(K) + sizeof(V));
+  bool put(const K& key, V&& value, std::size_t bytes = sizeof(K) + sizeof(V));
+  bool touch(const K& key);
+  bool erase(const K& key);
+  bool evict();
+  bool contains(const K& key) const;
+  bool empty() const;
+  std::size_t size() const;
+  std::size_t bytes() const;
+  std::size_t max_entries() const;
+  std::size_t max_bytes() const;
+
+  std::size_t hits() const;
+  std::size_t misses() const;
+  std::size_t evictions() const;
+  void reset_counters();
+
+ private:
+  struct Entry {
+    Entry(const K& key, V&& value, std::size_t bytes)
+        : key{key}, value{std::move(value)}, bytes{bytes} {}
+
+    K key;
+    V value;
+    std::size_t bytes;
+  };
+
+  using List = DoublyLinkedList<Entry, PoolAllocator<Entry>>;
+  using Position = typename List::iterator;
+
+  bool store(const K& key, V&& value, std::size_t bytes);
+  void fit();
+  void drop(Position position);
+
+  List entries_;  // most recently used first
+  std::unordered_map<K, Position, Hash> index_;
+  std::size_t bytes_{0u};
+  std::size_t max_entries_;
+  std::size_t max_bytes_;
+  std::size_t hits_{0u};
+  std::size_t misses_{0u};
+  std::size_t evictions_{0u};
+};
+/**
+ * Constructor. Sets the budgets.
+ * \param max_entries maximum number of entries (at least one);
+ * \param max_bytes maximum sum of the entries' charges.
+ */
+template <typename K, typename V, typename Hash>
+LruCache<K, V, Hash>::LruCache(std::size_t max_entries,
+                               std::size_t max_bytes)
+    : max_entries_{max_entries}, max_bytes_{max_bytes} {
+  if (max_entries == 0) {
+    throw std::out_of_range("Parâmetro inválido");
+  }
+  index_.reserve(max_entries < 1024 ? max_entries : 1024);
+}
+/**
+ * Clears the cache. The counters are kept.
+ */
+template <typename K, typename V, typename Hash>
+void LruCache<K, V, Hash>::clear() {
+  index_.clear();
+  entries_.clear();
+  bytes_ = 0;
+}
+/**
+ * Looks a key up, making it the most recently used on a hit.
+ * \return pointer to the value, valid until the cache changes, or nullptr
+ * on a miss.
+ */
+template <typename K, typename V, typename Hash>
+V* LruCache<K, V, Hash>::get(const K& key) {
+  auto found = index_.find(key);
+  if (found == index_.end()) {
+    misses_++;
+    return nullptr;
+  }
+  hits_++;
+  entries_.splice(entries_.begin(), entries_, found->second);
+  return &found->second->value;
+}
+/**
+ * Inserts or replaces the value of a key as the most recently used entry,
+ * then evicts until both budgets hold.
+ * \param bytes charge of the entry against the byte budget.
+ * \return false if the entry alone exceeds the byte budget (it is not
+ * kept, and an older value of the key is removed).
+ */
+template <typename K, typename V, typename Hash>
+bool LruCache<K, V, Hash>::put(const K& key, const V& value,
+                               std::size_t bytes) {
+  V copy(value);
+  return store(key, std::move(copy), bytes);
+}
+/**
+ * Same as put(key, value, bytes), moving the value in.
+ */
+template <typename K, typename V, typename Hash>
+bool LruCache<K, V, Hash>::put(const K& key, V&& value, std::size_t bytes) {
+  return store(key, std::move(value), bytes);
+}
+/**
+ * Makes a key the most recently used without counting a hit.
+ * \return whether the key is cached.
+ */
+template <typename K, typename V, typename Hash>
+bool LruCache<K, V, Hash>::touch(const K& key) {
+  auto found = index_.find(key);
+  if (found == index_.end()) {
+    return false;
+  }
+  entries_.splice(entries_.begin(), entries_, found->second);
+  return true;
+}
+/**
+ * Removes a key.
+ * \return whether the key was cached.
+ */
+template <typename K, typename V, typename Hash>
+bool LruCache<K, V, Hash>::erase(const K& key) {
+  auto found = index_.find(key);
+  if (found == index_.end()) {
+    return false;
+  }
+  Position position = found->second;
+  index_.erase(found);
+  drop(position);
+  return true;
+}
+/**
+ * Evicts the least recently used entry.
+ * \return false if the cache is empty.
+ */
+template <typename K, typename V, typename Hash>
+bool LruCache<K, V, Hash>::evict() {
+  if (entries_.empty()) {
+    return false;
+  }
+  Position last = entries_.end();
+  --last;
+  index_.erase(last->key);
+  drop(last);
+  evictions_++;
+  return true;
+}
+/**
+ * Checks if a key is cached, without changing its recency.
+ * \return boolean
+ */
+template <typename K, typename V, typename Hash>
+bool LruCache<K, V, Hash>::contains(const K& key) const {
+  return index_.find(key) != index_.end();
+}
+/**
+ * Checks if the cache is empty.
+ * \return boolean
+ */
+template <typename K, typename V, typename Hash>
+bool LruCache<K, V, Hash>::empty() const {
+  return entries_.empty();
+}
+/**
+ * Returns the number of cached entries.
+ */
+template <typename K, typename V, typename Hash>
+std::size_t LruCache<K, V, Hash>::size() const {
+  return entries_.size();
+}
+/**
+ * Returns the sum of the cached entries' charges.
+ */
+template <typename K, typename V, typename Hash>
+std::size_t LruCache<K, V, Hash>::bytes() const {
+  return bytes_;
+}
+/**
+ * Returns the entry budget.
+ */
+template <typename K, typename V, typename Hash>
+std::size_t LruCache<K, V, Hash>::max_entries() const {
+  return max_entries_;
+}
+/**
+ * Returns the byte budget.
+ */
+template <typename K, typename V, typename Hash>
+std::size_t LruCache<K, V, Hash>::max_bytes() const {
+  return max_bytes_;
+}
+/**
+ * Returns how many get calls found their key.
+ */
+template <typename K, typename V, typename Hash>
+std::size_t LruCache<K, V, Hash>::hits() const {
+  return hits_;
+}
+/**
+ * Returns how many get calls missed.
+ */
+template <typename K, typename V, typename Hash>
+std::size_t LruCache<K, V, Hash>::misses() const {
+  return misses_;
+}
+/**
+ * Returns how many entries were evicted, by a budget or by evict().
+ */
+template <typename K, typename V, typename Hash>
+std::size_t LruCache<K, V, Hash>::evictions() const {
+  return evictions_;
+}
+/**
+ * Sets the hit, miss and eviction counters back to zero.
+ */
+template <typename K, typename V, typename Hash>
+void LruCache<K, V, Hash>::reset_counters() {
+  hits_ = 0;
+  misses_ = 0;
+  evictions_ = 0;
+}
+/**
+ * Replaces or inserts the entry of key at the front and restores the
+ * budgets.
+ */
+template <typename K, typename V, typename Hash>
+bool LruCache<K, V, Hash>::store(const K& key, V&& value,
+                                 std::size_t bytes) {
+  auto found = index_.find(key);
+  if (found != index_.end()) {
+    Position position = found->second;
+    bytes_ -= position->bytes;
+    position->value = std::move(value);
+    position->bytes = bytes;
+    bytes_ += bytes;
+    entries_.splice(entries_.begin(), entries_, position);
+  } else {
+    entries_.emplace_front(key, std::move(value), bytes);
+    try {
+      index_.emplace(key, entries_.begin());
+    } catch (...) {
+      entries_.pop_front();
+      throw;
+    }
+    bytes_ += bytes;
+  }
+  if (bytes > max_bytes_) {
+    erase(key);
+    return false;
+  }
+  fit();
+  return true;
+}
+/**
+ * Evicts least recently used entries until both budgets hold.
+ */
+template <typename K, typename V, typename Hash>
+void LruCache<K, V, Hash>::fit() {
+  while (entries_.size() > max_entries_ || bytes_ > max_bytes_) {
+    evict();
+  }
+}
+/**
+ * Frees the node at position, already taken out of the index.
+ */
+template <typename K, typename V, typename Hash>
+void LruCache<K, V, Hash>::drop(Position position) {
+  bytes_ -= position->bytes;
+  entries_.erase(position);
+}
+}  // namespace structures
+
+#endif
@@ -0,0 +1,191 @@
+// Copyright 2017 Eduardo Kohler
+
+#ifndef STRUCTURES_CONCURRENT_LINKED_QUEUE_H
+#define STRUCTURES_CONCURRENT_LINKED_QUEUE_H
+
+#include <atomic>     // std::atomic
+#include <cstdint>    // std::size_t
+#include <stdexcept>  // C++ Exceptions
+
+#include "./hazard_pointers.h"
+
+namespace structures {
+/**
+ * Fila encadeada sem travas e sem limite de tamanho (Michael-Scott).
+ *
+ * head_ aponta sempre para um nodo sentinela; o primeiro dado está em
+ * head_->next(). Produtores ligam o novo nodo ao fim com CAS e ajudam a
+ * avançar tail_ quando ele fica para trás. Os nodos retirados passam por
+ * HazardPointers, então dequeue nunca deleta um nodo que outra thread
+ * ainda esteja lendo.
+ */
+template <typename T>
+class ConcurrentLinkedQueue {
+ public:
+  ConcurrentLinkedQueue();
+
+  ConcurrentLinkedQueue(const ConcurrentLinkedQueue&) = delete;
+
+  ConcurrentLinkedQueue& operator=(const ConcurrentLinkedQueue&) = delete;
+
+  ~ConcurrentLinkedQueue();
+
+  void clear();  // limpar
+
+  void enqueue(const T& data);  // enfilerar
+
+  T dequeue();  // desenfilerar
+
+  bool try_dequeue(T& data);  // desenfilerar sem exceção
+
+  bool empty() const;  // fila vazia
+
+  std::size_t size() const;  // tamanho (aproximado com outras threads)
+
+ private:
+  class Node {
+   public:
+    Node() : next_{nullptr} {}
+    explicit Node(const T& data) : data_{data}, next_{nullptr} {}
+
+    T& data() { return data_; }
+    const T& data() const { return data_; }
+
+    Node* next() { return next_.load(); }
+    const Node* next() const { return next_.load(); }
+
+    std::atomic<Node*>& link() { return next_; }
+
+   private:
+    T data_;
+    std::atomic<Node*> next_;
+  };
+
+  std::atomic<Node*> head_;        // nodo sentinela
+  std::atomic<Node*> tail_;        // último nodo (ou quase)
+  std::atomic<std::size_t> size_;  // tamanho
+};
+/**
+ * Construtor. Cria o nodo sentinela.
+ */
+template <typename T>
+ConcurrentLinkedQueue<T>::ConcurrentLinkedQueue() {
+  Node* sentinel = new Node();
+  head_.store(sentinel);
+  tail_.store(sentinel);
+  size_.store(0);
+}
+/**
+ * Destrutor. Deleta os nodos restantes; nenhuma outra thread pode estar
+ * usando a fila neste ponto.
+ */
+template <typename T>
+ConcurrentLinkedQueue<T>::~ConcurrentLinkedQueue() {
+  Node* current = head_.load();
+  while (current != nullptr) {
+    Node* next = current->next();
+    delete current;
+    current = next;
+  }
+}
+/**
+ * Coloca um elemento no fim da fila.
+ * \param referência de um dado.
+ */
+template <typename T>
+void ConcurrentLinkedQueue<T>::enqueue(const T& data) {
+  Node* input = new Node(data);
+  size_++;
+  for (;;) {
+    Node* tail = HazardPointers::protect(0, tail_);
+    Node* next = tail->next();
+    if (tail != tail_.load()) {
+      continue;
+    }
+    if (next != nullptr) {
+      tail_.compare_exchange_weak(tail, next);
+      continue;
+    }
+    if (tail->link().compare_exchange_weak(next, input)) {
+      tail_.compare_exchange_strong(tail, input);
+      break;
+    }
+  }
+  HazardPointers::clear(0);
+}
+/**
+ * Retira o elemento do começo da fila, se houver.
+ * \param data recebe o elemento retirado.
+ * \return false se a fila estiver vazia.
+ */
+template <typename T>
+bool ConcurrentLinkedQueue<T>::try_dequeue(T& data) {
+  Node* head;
+  for (;;) {
+    head = HazardPointers::protect(0, head_);
+    Node* tail = tail_.load();
+    Node* next = HazardPointers::protect(1, head->link());
+    if (head != head_.load()) {
+      continue;
+    }
+    if (next == nullptr) {
+      HazardPointers::clear(0);
+      HazardPointers::clear(1);
+      return false;
+    }
+    if (head == tail) {
+      tail_.compare_exchange_weak(tail, next);
+      continue;
+    }
+    T output = next->data();
+    if (head_.compare_exchange_weak(head, next)) {
+      data = output;
+      break;
+    }
+  }
+  HazardPointers::clear(0);
+  HazardPointers::clear(1);
+  HazardPointers::retire(head);
+  size_--;
+  return true;
+}
+/**
+ * Retira o elemento do começo da fila.
+ * \return elemento do começo da fila.
+ */
+template <typename T>
+T ConcurrentLinkedQueue<T>::dequeue() {
+  T output;
+  if (!try_dequeue(output)) {
+    throw std::out_of_range("Fila vazia");
+  }
+  return output;
+}
+/**
+ * Limpa a fila.
+ */
+template <typename T>
+void ConcurrentLinkedQueue<T>::clear() {
+  T discarded;
+  while (try_dequeue(discarded)) {
+  }
+}
+/**
+ * Retorna o tamanho da fila.
+ * \return tamanho da fila.
+ */
+template <typename T>
+std::size_t ConcurrentLinkedQueue<T>::size() const {
+  return size_.load();
+}
+/**
+ * Verifica se a fila está vazia.
+ *\return booleano
+ */
+template <typename T>
+bool ConcurrentLinkedQueue<T>::empty() const {
+  return size() == 0;
+}
+}  // namespace structures
+
+#endif
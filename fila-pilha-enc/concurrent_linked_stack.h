@@ -0,0 +1,281 @@
+// Copyright 2017 Eduardo Kohler
+
+#ifndef STRUCTURES_CONCURRENT_LINKED_STACK_H
+#define STRUCTURES_CONCURRENT_LINKED_STACK_H
+
+#include <atomic>     // std::atomic
+#include <cstdint>    // std::size_t, std::uintptr_t
+#include <stdexcept>  // C++ Exceptions
+
+#include "./hazard_pointers.h"
+
+namespace structures {
+/**
+ * Pilha encadeada sem travas (Treiber) com vetor de eliminação.
+ *
+ * push e pop trocam top_ com CAS. O nodo lido em top_ fica publicado em
+ * um hazard pointer até o fim da troca, então ele não pode ser deletado e
+ * reaproveitado no meio dela (o que causaria ABA). Quando o CAS falha por
+ * disputa, push oferece o nodo em uma posição aleatória de exchanger_ e um
+ * pop concorrente pode levá-lo direto, sem tocar em top_.
+ */
+template <typename T>
+class ConcurrentLinkedStack {
+ public:
+  ConcurrentLinkedStack();
+
+  ConcurrentLinkedStack(const ConcurrentLinkedStack&) = delete;
+
+  ConcurrentLinkedStack& operator=(const ConcurrentLinkedStack&) = delete;
+
+  ~ConcurrentLinkedStack();
+
+  void clear();  // limpa pilha
+
+  void push(const T& data);  // empilha
+
+  T pop();  // desempilha
+
+  bool try_pop(T& data);  // desempilha sem exceção
+
+  T top() const;  // cópia do dado no topo
+
+  bool empty() const;  // pilha vazia
+
+  std::size_t size() const;  // tamanho (aproximado com outras threads)
+
+ private:
+  class Node {
+   public:
+    explicit Node(const T& data) : data_{data} {}
+
+    T& data() { return data_; }
+    const T& data() const { return data_; }
+
+    Node* next() { return next_; }
+    const Node* next() const { return next_; }
+
+    void next(Node* node) { next_ = node; }
+
+   private:
+    T data_;
+    Node* next_{nullptr};
+  };
+
+  enum class Attempt { done, empty, contended };
+
+  Attempt try_pop_top(T& data);
+  bool eliminate_push(Node* node);
+  Node* eliminate_pop();
+
+  static std::size_t random_slot();
+
+  /**
+   * Marca de posição de eliminação cujo nodo já foi levado por um pop; só
+   * o push dono do nodo volta a posição para nullptr.
+   */
+  static Node* taken() { return reinterpret_cast<Node*>(std::uintptr_t{1}); }
+
+  static const std::size_t ELIMINATION_SLOTS = 8;    // posições de troca
+  static const std::size_t ELIMINATION_SPINS = 128;  // espera por um pop
+
+  std::atomic<Node*> top_;         // nodo-topo
+  std::atomic<std::size_t> size_;  // tamanho
+  std::atomic<Node*> exchanger_[ELIMINATION_SLOTS];
+};
+/**
+ * Construtor. Determina o valor dos atributos na criação do objeto.
+ */
+template <typename T>
+ConcurrentLinkedStack<T>::ConcurrentLinkedStack() {
+  top_.store(nullptr);
+  size_.store(0);
+  for (auto& slot : exchanger_) {
+    slot.store(nullptr);
+  }
+}
+/**
+ * Destrutor. Deleta os nodos restantes; nenhuma outra thread pode estar
+ * usando a pilha neste ponto.
+ */
+template <typename T>
+ConcurrentLinkedStack<T>::~ConcurrentLinkedStack() {
+  Node* current = top_.load();
+  while (current != nullptr) {
+    Node* next = current->next();
+    delete current;
+    current = next;
+  }
+}
+/**
+ * Coloca um elemento no topo da pilha.
+ * \param referência de um dado.
+ */
+template <typename T>
+void ConcurrentLinkedStack<T>::push(const T& data) {
+  Node* input = new Node(data);
+  size_++;
+  for (;;) {
+    Node* top = top_.load();
+    input->next(top);
+    if (top_.compare_exchange_weak(top, input)) {
+      return;
+    }
+    if (eliminate_push(input)) {
+      size_--;
+      return;
+    }
+  }
+}
+/**
+ * Uma tentativa de retirar o topo da pilha principal.
+ */
+template <typename T>
+typename ConcurrentLinkedStack<T>::Attempt
+ConcurrentLinkedStack<T>::try_pop_top(T& data) {
+  Node* top = HazardPointers::protect(0, top_);
+  if (top == nullptr) {
+    return Attempt::empty;
+  }
+  if (!top_.compare_exchange_weak(top, top->next())) {
+    HazardPointers::clear(0);
+    return Attempt::contended;
+  }
+  HazardPointers::clear(0);
+  data = top->data();
+  HazardPointers::retire(top);
+  size_--;
+  return Attempt::done;
+}
+/**
+ * Retira o elemento do topo da pilha, se houver.
+ * \param data recebe o elemento retirado.
+ * \return false se a pilha estiver vazia.
+ */
+template <typename T>
+bool ConcurrentLinkedStack<T>::try_pop(T& data) {
+  for (;;) {
+    Attempt attempt = try_pop_top(data);
+    if (attempt == Attempt::done) {
+      return true;
+    } else if (attempt == Attempt::empty) {
+      return false;
+    }
+    Node* eliminated = eliminate_pop();
+    if (eliminated != nullptr) {
+      data = eliminated->data();
+      delete eliminated;
+      return true;
+    }
+  }
+}
+/**
+ * Oferece o nodo a um pop concorrente por algumas voltas.
+ * \return true se um pop levou o nodo.
+ */
+template <typename T>
+bool ConcurrentLinkedStack<T>::eliminate_push(Node* node) {
+  std::atomic<Node*>& slot = exchanger_[random_slot()];
+  Node* expected = nullptr;
+  if (!slot.compare_exchange_strong(expected, node)) {
+    return false;
+  }
+  for (std::size_t i = 0; i < ELIMINATION_SPINS; i++) {
+    if (slot.load(std::memory_order_relaxed) != node) {
+      break;
+    }
+  }
+  expected = node;
+  if (slot.compare_exchange_strong(expected, nullptr)) {
+    return false;
+  }
+  slot.store(nullptr);
+  return true;
+}
+/**
+ * Tenta levar um nodo oferecido por um push concorrente.
+ * \return o nodo levado, ou nullptr.
+ */
+template <typename T>
+typename ConcurrentLinkedStack<T>::Node*
+ConcurrentLinkedStack<T>::eliminate_pop() {
+  std::atomic<Node*>& slot = exchanger_[random_slot()];
+  Node* node = slot.load();
+  if (node == nullptr || node == taken()) {
+    return nullptr;
+  }
+  if (slot.compare_exchange_strong(node, taken())) {
+    return node;
+  }
+  return nullptr;
+}
+/**
+ * Sorteia uma posição de eliminação (xorshift por thread).
+ */
+template <typename T>
+std::size_t ConcurrentLinkedStack<T>::random_slot() {
+  static thread_local std::uint32_t state = 0;
+  if (state == 0) {
+    state = static_cast<std::uint32_t>(
+                reinterpret_cast<std::uintptr_t>(&state) >> 4) | 1u;
+  }
+  state ^= state << 13;
+  state ^= state >> 17;
+  state ^= state << 5;
+  return state % ELIMINATION_SLOTS;
+}
+/**
+ * Retira o elemento do topo da pilha.
+ * \return elemento do topo da pilha.
+ */
+template <typename T>
+T ConcurrentLinkedStack<T>::pop() {
+  T output;
+  if (!try_pop(output)) {
+    throw std::out_of_range("Pilha vazia");
+  }
+  return output;
+}
+/**
+ * Retorna uma cópia do membro do topo da pilha. Uma referência não seria
+ * segura, já que outra thread pode desempilhá-lo logo em seguida.
+ * \return membro do topo.
+ */
+template <typename T>
+T ConcurrentLinkedStack<T>::top() const {
+  Node* top = HazardPointers::protect(0, top_);
+  if (top == nullptr) {
+    throw std::out_of_range("Pilha vazia");
+  }
+  T output = top->data();
+  HazardPointers::clear(0);
+  return output;
+}
+/**
+ * Limpa a pilha.
+ */
+template <typename T>
+void ConcurrentLinkedStack<T>::clear() {
+  T discarded;
+  while (try_pop(discarded)) {
+  }
+}
+/**
+ * Retorna o tamanho da pilha.
+ * \return tamanho da pilha.
+ */
+template <typename T>
+std::size_t ConcurrentLinkedStack<T>::size() const {
+  return size_.load();
+}
+/**
+ * Verifica se a pilha está vazia.
+ *\return booleano
+ */
+template <typename T>
+bool ConcurrentLinkedStack<T>::empty() const {
+  return size() == 0;
+}
+}  // namespace structures
+
+#endif
@@ -0,0 +1,193 @@
+// Copyright 2017 Eduardo Kohler
+
+#ifndef STRUCTURES_HAZARD_POINTERS_H
+#define STRUCTURES_HAZARD_POINTERS_H
+
+#include <algorithm>  // std::sort, std::binary_search
+#include <atomic>     // std::atomic
+#include <cstdint>    // std::size_t
+#include <vector>     // std::vector
+
+namespace structures {
+/**
+ * Hazard pointers: reciclagem segura de nodos em estruturas sem travas.
+ *
+ * Antes de desreferenciar um nodo compartilhado, a thread o publica em um
+ * dos seus SLOTS com protect(). Nodos desligados da estrutura vão para
+ * retire() e só são deletados quando nenhuma thread os tiver publicado.
+ * Cada thread recebe um registro na primeira chamada; ao terminar, o
+ * registro é devolvido (com os nodos ainda pendentes) para reuso.
+ */
+class HazardPointers {
+ public:
+  static const std::size_t SLOTS = 2;  // hazard pointers por thread
+
+  /**
+   * Lê source e publica o valor no slot até que a leitura se confirme.
+   * \return ponteiro protegido (pode ser nullptr).
+   */
+  template <typename N>
+  static N* protect(std::size_t slot, const std::atomic<N*>& source) {
+    std::atomic<void*>& hazard = local()->hazards[slot];
+    N* pointer = source.load();
+    for (;;) {
+      hazard.store(pointer);
+      N* current = source.load();
+      if (current == pointer) {
+        return pointer;
+      }
+      pointer = current;
+    }
+  }
+
+  /**
+   * Libera o slot da thread atual.
+   */
+  static void clear(std::size_t slot) {
+    local()->hazards[slot].store(nullptr, std::memory_order_release);
+  }
+
+  /**
+   * Entrega um nodo já desligado da estrutura para ser deletado quando
+   * nenhuma thread o estiver usando.
+   */
+  template <typename N>
+  static void retire(N* node) {
+    Record* record = local();
+    record->retired.push_back(Retired{node, &destroy<N>});
+    std::size_t threshold =
+        2 * SLOTS * registry().count.load(std::memory_order_relaxed) +
+        SCAN_THRESHOLD;
+    if (record->retired.size() >= threshold) {
+      scan(record);
+    }
+  }
+
+ private:
+  static const std::size_t SCAN_THRESHOLD = 64;  // folga mínima entre scans
+
+  struct Retired {
+    void* pointer;
+    void (*deleter)(void*);
+  };
+
+  struct Record {
+    std::atomic<void*> hazards[SLOTS];
+    std::atomic<bool> active{true};
+    Record* next{nullptr};
+    std::vector<Retired> retired;
+
+    Record() {
+      for (auto& hazard : hazards) {
+        hazard.store(nullptr, std::memory_order_relaxed);
+      }
+    }
+  };
+
+  /**
+   * Lista global de registros. Só cresce; no fim do programa deleta os
+   * registros e os nodos que ainda estiverem pendentes.
+   */
+  struct Registry {
+    std::atomic<Record*> head{nullptr};
+    std::atomic<std::size_t> count{0};
+
+    ~Registry() {
+      Record* record = head.load();
+      while (record != nullptr) {
+        Record* next = record->next;
+        for (auto& retired : record->retired) {
+          retired.deleter(retired.pointer);
+        }
+        delete record;
+        record = next;
+      }
+    }
+  };
+
+  /**
+   * Mantém o registro da thread e o devolve quando a thread termina.
+   */
+  struct Owner {
+    Record* record;
+
+    Owner() : record{acquire()} {}
+
+    ~Owner() {
+      for (auto& hazard : record->hazards) {
+        hazard.store(nullptr);
+      }
+      scan(record);
+      record->active.store(false, std::memory_order_release);
+    }
+  };
+
+  template <typename N>
+  static void destroy(void* pointer) {
+    delete static_cast<N*>(pointer);
+  }
+
+  static Registry& registry() {
+    static Registry instance;
+    return instance;
+  }
+
+  static Record* local() {
+    static thread_local Owner owner;
+    return owner.record;
+  }
+
+  /**
+   * Reaproveita um registro inativo ou cria um novo.
+   */
+  static Record* acquire() {
+    Registry& reg = registry();
+    for (Record* record = reg.head.load(); record != nullptr;
+         record = record->next) {
+      bool inactive = false;
+      if (!record->active.load(std::memory_order_relaxed) &&
+          record->active.compare_exchange_strong(inactive, true)) {
+        return record;
+      }
+    }
+    Record* record = new Record();
+    Record* head = reg.head.load();
+    do {
+      record->next = head;
+    } while (!reg.head.compare_exchange_weak(head, record));
+    reg.count.fetch_add(1, std::memory_order_relaxed);
+    return record;
+  }
+
+  /**
+   * Deleta os nodos aposentados do registro que não aparecem em nenhum
+   * hazard pointer publicado.
+   */
+  static void scan(Record* owner) {
+    std::vector<void*> hazards;
+    for (Record* record = registry().head.load(); record != nullptr;
+         record = record->next) {
+      for (auto& hazard : record->hazards) {
+        void* pointer = hazard.load();
+        if (pointer != nullptr) {
+          hazards.push_back(pointer);
+        }
+      }
+    }
+    std::sort(hazards.begin(), hazards.end());
+
+    std::vector<Retired> kept;
+    for (auto& retired : owner->retired) {
+      if (std::binary_search(hazards.begin(), hazards.end(),
+                             retired.pointer)) {
+        kept.push_back(retired);
+      } else {
+        retired.deleter(retired.pointer);
+      }
+    }
+    owner->retired.swap(kept);
+  }
+};
+}  // namespace structures
+
+#endif
@@ -1,26 +1,48 @@
 // Copyright 2017 Eduardo Kohler
 
-#ifndef STRUCTURES_ARRAY_QUEUE_H
-#define STRUCTURES_ARRAY_QUEUE_H
+#ifndef STRUCTURES_LINKED_QUEUE_H
+#define STRUCTURES_LINKED_QUEUE_H
 
-#include <cstdint>    // std::size_t
-#include <stdexcept>  // C++ Exceptions
+#include <cstdint>      // std::size_t
+#include <memory>       // std::allocator, std::allocator_traits
+#include <stdexcept>    // C++ Exceptions
+#include <type_traits>  // std::is_trivially_destructible
+#include <utility>      // std::forward, std::move, std::swap
+
+#include "../memoria/node_pool.h"
 
 namespace structures {
 /**
  * Implementação de uma fila encadeada com template, (FIFO).
+ *
+ * Os nodos vêm de Alloc (por exemplo PoolAllocator<T>).
  */
-template <typename T>
+template <typename T, typename Alloc = std::allocator<T>>
 class LinkedQueue {
  public:
   LinkedQueue();
 
+  LinkedQueue(const LinkedQueue& other);  // cópia
+
+  LinkedQueue(LinkedQueue&& other);  // movimento
+
+  LinkedQueue& operator=(const LinkedQueue& other);
+
+  LinkedQueue& operator=(LinkedQueue&& other);
+
   ~LinkedQueue();
 
   void clear();  // limpar
 
+  void swap(LinkedQueue& other);  // troca o conteúdo
+
   void enqueue(const T& data);  // enfilerar
 
+  void enqueue(T&& data);  // enfilerar (movendo)
+
+  template <typename... Args>
+  void emplace(Args&&... args);  // constrói no fim
+
   T dequeue();  // desenfilerar
 
   T& front() const;  // primeiro dado
@@ -32,9 +54,15 @@ class LinkedQueue {
   std::size_t size() const;  // tamanho
 
  private:
+  struct InPlace {};  // marca: constrói o dado a partir dos argumentos
+
   class Node {
    public:
     explicit Node(const T& data) : data_{data} {}
+    explicit Node(T&& data) : data_{std::move(data)} {}
+    template <typename... Args>
+    explicit Node(InPlace, Args&&... args)
+        : data_(std::forward<Args>(args)...) {}
     Node(const T& data, Node* next) : data_{data}, next_{next} {}
 
     T& data() { return data_; }
@@ -47,57 +75,154 @@ class LinkedQueue {
 
    private:
     T data_;
-    Node* next_;
+    Node* next_{nullptr};
   };
 
-  Node* head_;        // nodo-cabeça
-  Node* tail_;        // nodo-fim
-  std::size_t size_;  // tamanho
+  using NodeAlloc =
+      typename std::allocator_traits<Alloc>::template rebind_alloc<Node>;
+  using NodeTraits = std::allocator_traits<NodeAlloc>;
+
+  template <typename... Args>
+  Node* new_node(Args&&... args) {
+    Node* node = NodeTraits::allocate(node_alloc_, 1);
+    try {
+      NodeTraits::construct(node_alloc_, node, std::forward<Args>(args)...);
+    } catch (...) {
+      NodeTraits::deallocate(node_alloc_, node, 1);
+      throw;
+    }
+    return node;
+  }
+
+  void delete_node(Node* node) {
+    NodeTraits::destroy(node_alloc_, node);
+    NodeTraits::deallocate(node_alloc_, node, 1);
+  }
+
+  void link(Node* node);
+
+  Node* head_{nullptr};   // nodo-cabeça
+  Node* tail_{nullptr};   // nodo-fim
+  std::size_t size_{0u};  // tamanho
+  NodeAlloc node_alloc_;  // alocador de nodos
 };
 /**
  * Construtor. Determina o valor dos atributos na criação do objeto.
  */
-template <typename T>
-LinkedQueue<T>::LinkedQueue() {
+template <typename T, typename Alloc>
+LinkedQueue<T, Alloc>::LinkedQueue() {
   head_ = nullptr;
   tail_ = nullptr;
   size_ = 0;
 }
+/**
+ * Construtor de cópia. Copia os elementos de other, na mesma ordem.
+ */
+template <typename T, typename Alloc>
+LinkedQueue<T, Alloc>::LinkedQueue(const LinkedQueue& other)
+    : node_alloc_{NodeTraits::select_on_container_copy_construction(
+          other.node_alloc_)} {
+  try {
+    for (const Node* it = other.head_; it != nullptr; it = it->next()) {
+      link(new_node(it->data()));
+    }
+  } catch (...) {
+    clear();
+    throw;
+  }
+}
+/**
+ * Construtor de movimento. Toma os nodos de other, que fica vazia.
+ */
+template <typename T, typename Alloc>
+LinkedQueue<T, Alloc>::LinkedQueue(LinkedQueue&& other)
+    : head_{other.head_},
+      tail_{other.tail_},
+      size_{other.size_},
+      node_alloc_{other.node_alloc_} {
+  other.head_ = nullptr;
+  other.tail_ = nullptr;
+  other.size_ = 0;
+}
+/**
+ * Atribuição por cópia.
+ */
+template <typename T, typename Alloc>
+LinkedQueue<T, Alloc>& LinkedQueue<T, Alloc>::operator=(
+    const LinkedQueue& other) {
+  LinkedQueue copy(other);
+  swap(copy);
+  return *this;
+}
+/**
+ * Atribuição por movimento. Os elementos anteriores são destruídos.
+ */
+template <typename T, typename Alloc>
+LinkedQueue<T, Alloc>& LinkedQueue<T, Alloc>::operator=(
+    LinkedQueue&& other) {
+  LinkedQueue moved(std::move(other));
+  swap(moved);
+  return *this;
+}
 /**
  * Destrutor. Deleta o array contents.
  */
-template <typename T>
-LinkedQueue<T>::~LinkedQueue() {
+template <typename T, typename Alloc>
+LinkedQueue<T, Alloc>::~LinkedQueue() {
   clear();
 }
 /**
  * Coloca um elemento no fim da fila.
  * \param referência de um dado.
  */
-template <typename T>
-void LinkedQueue<T>::enqueue(const T& data) {
-  Node* input = new Node(data, nullptr);
+template <typename T, typename Alloc>
+void LinkedQueue<T, Alloc>::enqueue(const T& data) {
+  link(new_node(data, nullptr));
+}
+/**
+ * Coloca um elemento no fim da fila, movendo-o.
+ * \param dado a ser movido.
+ */
+template <typename T, typename Alloc>
+void LinkedQueue<T, Alloc>::enqueue(T&& data) {
+  link(new_node(std::move(data)));
+}
+/**
+ * Constrói um elemento no fim da fila a partir dos argumentos.
+ * \param argumentos do construtor de T.
+ */
+template <typename T, typename Alloc>
+template <typename... Args>
+void LinkedQueue<T, Alloc>::emplace(Args&&... args) {
+  link(new_node(InPlace{}, std::forward<Args>(args)...));
+}
+/**
+ * Encadeia um nodo já construído no fim da fila.
+ * \param nodo a ser encadeado.
+ */
+template <typename T, typename Alloc>
+void LinkedQueue<T, Alloc>::link(Node* node) {
   if (empty()) {
-    head_ = input;
+    head_ = node;
   } else {
-    tail_->next(input);
+    tail_->next(node);
   }
-  tail_ = input;
+  tail_ = node;
   size_++;
 }
 /**
  * Retira o elemento do começo da fila.
  * \return elemento do começo da fila.
  */
-template <typename T>
-T LinkedQueue<T>::dequeue() {
+template <typename T, typename Alloc>
+T LinkedQueue<T, Alloc>::dequeue() {
   if (empty()) {
     throw std::out_of_range("Fila vazia");
   } else {
     Node* removed = head_;
-    T output = head_->data();
+    T output(std::move(head_->data()));
     head_ = head_->next();
-    delete removed;
+    delete_node(removed);
     size_--;
     return output;
   }
@@ -106,8 +231,8 @@ T LinkedQueue<T>::dequeue() {
  * Retorna o membro do início da fila.
  *\return referência do membro do início.
  */
-template <typename T>
-T& LinkedQueue<T>::front() const {
+template <typename T, typename Alloc>
+T& LinkedQueue<T, Alloc>::front() const {
   if (empty()) {
     throw std::out_of_range("Fila vazia");
   } else {
@@ -118,8 +243,8 @@ T& LinkedQueue<T>::front() const {
  * Retorna o membro do fim da fila.
  *\return referência do membro do final.
  */
-template <typename T>
-T& LinkedQueue<T>::back() const {
+template <typename T, typename Alloc>
+T& LinkedQueue<T, Alloc>::back() const {
   if (empty()) {
     throw std::out_of_range("Fila vazia");
   } else {
@@ -127,28 +252,55 @@ T& LinkedQueue<T>::back() const {
   }
 }
 /**
- * Limpa a fila.
+ * Limpa a fila. Os nodos são destruídos sem copiar os dados; com um
+ * PoolAllocator o pool inteiro é devolvido de uma vez.
  */
-template <typename T>
-void LinkedQueue<T>::clear() {
-  while (!empty()) {
-    dequeue();
+template <typename T, typename Alloc>
+void LinkedQueue<T, Alloc>::clear() {
+  bool bulk = BulkRelease<NodeAlloc>::available(node_alloc_);
+  if (!bulk || !std::is_trivially_destructible<T>::value) {
+    Node* current = head_;
+    for (std::size_t i = 0; i < size_; i++) {
+      Node* next = current->next();
+      if (bulk) {
+        NodeTraits::destroy(node_alloc_, current);
+      } else {
+        delete_node(current);
+      }
+      current = next;
+    }
+  }
+  if (bulk) {
+    BulkRelease<NodeAlloc>::release(node_alloc_);
   }
+  head_ = nullptr;
+  tail_ = nullptr;
+  size_ = 0;
+}
+/**
+ * Troca o conteúdo de duas filas em O(1).
+ */
+template <typename T, typename Alloc>
+void LinkedQueue<T, Alloc>::swap(LinkedQueue& other) {
+  std::swap(head_, other.head_);
+  std::swap(tail_, other.tail_);
+  std::swap(size_, other.size_);
+  std::swap(node_alloc_, other.node_alloc_);
 }
 /**
  * Retorna o tamanho da fila.
  * \return tamanho da fila.
  */
-template <typename T>
-std::size_t LinkedQueue<T>::size() const {
+template <typename T, typename Alloc>
+std::size_t LinkedQueue<T, Alloc>::size() const {
   return size_;
 }
 /**
  * Verifica se a fila está vazia.
  *\return booleano
  */
-template <typename T>
-bool LinkedQueue<T>::empty() const {
+template <typename T, typename Alloc>
+bool LinkedQueue<T, Alloc>::empty() const {
   return size_ == 0;
 }
 }  // namespace structures
@@ -1,26 +1,48 @@
 // Copyright 2017 Eduardo Kohler
 
-#ifndef STRUCTURES_ARRAY_STACK_H
-#define STRUCTURES_ARRAY_STACK_H
+#ifndef STRUCTURES_LINKED_STACK_H
+#define STRUCTURES_LINKED_STACK_H
 
-#include <cstdint>
-#include <stdexcept>
+#include <cstdint>      // std::size_t
+#include <memory>       // std::allocator, std::allocator_traits
+#include <stdexcept>    // C++ Exceptions
+#include <type_traits>  // std::is_trivially_destructible
+#include <utility>      // std::forward, std::move, std::swap
+
+#include "../memoria/node_pool.h"
 
 namespace structures {
 /**
  * Implementação de uma pilha encadeada.
+ *
+ * Os nodos vêm de Alloc (por exemplo PoolAllocator<T>).
  */
-template <typename T>
+template <typename T, typename Alloc = std::allocator<T>>
 class LinkedStack {
  public:
   LinkedStack();
 
+  LinkedStack(const LinkedStack& other);  // cópia
+
+  LinkedStack(LinkedStack&& other);  // movimento
+
+  LinkedStack& operator=(const LinkedStack& other);
+
+  LinkedStack& operator=(LinkedStack&& other);
+
   ~LinkedStack();
 
   void clear();  // limpa pilha
 
+  void swap(LinkedStack& other);  // troca o conteúdo
+
   void push(const T& data);  // empilha
 
+  void push(T&& data);  // empilha (movendo)
+
+  template <typename... Args>
+  void emplace(Args&&... args);  // constrói no topo
+
   T pop();  // desempilha
 
   T& top() const;  // dado no topo
@@ -30,9 +52,15 @@ class LinkedStack {
   std::size_t size() const;  // tamanho da pilha
 
  private:
+  struct InPlace {};  // marca: constrói o dado a partir dos argumentos
+
   class Node {
    public:
     explicit Node(const T& data) : data_{data} {}
+    explicit Node(T&& data) : data_{std::move(data)} {}
+    template <typename... Args>
+    explicit Node(InPlace, Args&&... args)
+        : data_(std::forward<Args>(args)...) {}
     Node(const T& data, Node* next) : data_{data}, next_{next} {}
 
     T& data() { return data_; }
@@ -45,57 +73,154 @@ class LinkedStack {
 
    private:
     T data_;
-    Node* next_;
+    Node* next_{nullptr};
   };
 
-  Node* top_;         // nodo-topo
-  std::size_t size_;  // tamanho
+  using NodeAlloc =
+      typename std::allocator_traits<Alloc>::template rebind_alloc<Node>;
+  using NodeTraits = std::allocator_traits<NodeAlloc>;
+
+  template <typename... Args>
+  Node* new_node(Args&&... args) {
+    Node* node = NodeTraits::allocate(node_alloc_, 1);
+    try {
+      NodeTraits::construct(node_alloc_, node, std::forward<Args>(args)...);
+    } catch (...) {
+      NodeTraits::deallocate(node_alloc_, node, 1);
+      throw;
+    }
+    return node;
+  }
+
+  void delete_node(Node* node) {
+    NodeTraits::destroy(node_alloc_, node);
+    NodeTraits::deallocate(node_alloc_, node, 1);
+  }
+
+  void link(Node* node);
+
+  Node* top_{nullptr};    // nodo-topo
+  std::size_t size_{0u};  // tamanho
+  NodeAlloc node_alloc_;  // alocador de nodos
 };
 /**
  * Construtor. Determina o valor das variáveis e usa o parâmetro passado como
  * tamanho máximo.
  */
-template <typename T>
-LinkedStack<T>::LinkedStack() {
+template <typename T, typename Alloc>
+LinkedStack<T, Alloc>::LinkedStack() {
   top_ = nullptr;
   size_ = 0;
 }
+/**
+ * Construtor de cópia. Copia os elementos de other, preservando a ordem.
+ */
+template <typename T, typename Alloc>
+LinkedStack<T, Alloc>::LinkedStack(const LinkedStack& other)
+    : node_alloc_{NodeTraits::select_on_container_copy_construction(
+          other.node_alloc_)} {
+  Node* last = nullptr;
+  try {
+    for (const Node* it = other.top_; it != nullptr; it = it->next()) {
+      Node* input = new_node(it->data());
+      if (last == nullptr) {
+        top_ = input;
+      } else {
+        last->next(input);
+      }
+      last = input;
+      size_++;
+    }
+  } catch (...) {
+    clear();
+    throw;
+  }
+}
+/**
+ * Construtor de movimento. Toma os nodos de other, que fica vazia.
+ */
+template <typename T, typename Alloc>
+LinkedStack<T, Alloc>::LinkedStack(LinkedStack&& other)
+    : top_{other.top_}, size_{other.size_}, node_alloc_{other.node_alloc_} {
+  other.top_ = nullptr;
+  other.size_ = 0;
+}
+/**
+ * Atribuição por cópia.
+ */
+template <typename T, typename Alloc>
+LinkedStack<T, Alloc>& LinkedStack<T, Alloc>::operator=(
+    const LinkedStack& other) {
+  LinkedStack copy(other);
+  swap(copy);
+  return *this;
+}
+/**
+ * Atribuição por movimento. Os elementos anteriores são destruídos.
+ */
+template <typename T, typename Alloc>
+LinkedStack<T, Alloc>& LinkedStack<T, Alloc>::operator=(
+    LinkedStack&& other) {
+  LinkedStack moved(std::move(other));
+  swap(moved);
+  return *this;
+}
 /**
  * Destrutor. Deleta o array contents.
  */
-template <typename T>
-LinkedStack<T>::~LinkedStack() {
+template <typename T, typename Alloc>
+LinkedStack<T, Alloc>::~LinkedStack() {
   clear();
 }
 /**
  * Coloca um elemento no topo da pilha.
  * \param referência de um dado.
  */
-template <typename T>
-void LinkedStack<T>::push(const T& data) {
-  Node* input = new Node(data);
-  if (empty()) {
-    input->next(nullptr);
-  } else {
-    input->next(top_);
-  }
-  top_ = input;
+template <typename T, typename Alloc>
+void LinkedStack<T, Alloc>::push(const T& data) {
+  link(new_node(data));
+}
+/**
+ * Coloca um elemento no topo da pilha, movendo-o.
+ * \param dado a ser movido.
+ */
+template <typename T, typename Alloc>
+void LinkedStack<T, Alloc>::push(T&& data) {
+  link(new_node(std::move(data)));
+}
+/**
+ * Constrói um elemento no topo da pilha a partir dos argumentos.
+ * \param argumentos do construtor de T.
+ */
+template <typename T, typename Alloc>
+template <typename... Args>
+void LinkedStack<T, Alloc>::emplace(Args&&... args) {
+  link(new_node(InPlace{}, std::forward<Args>(args)...));
+}
+/**
+ * Encadeia um nodo já construído no topo da pilha.
+ * \param nodo a ser encadeado.
+ */
+template <typename T, typename Alloc>
+void LinkedStack<T, Alloc>::link(Node* node) {
+  node->next(top_);
+  top_ = node;
   size_++;
 }
 /**
  * Retira o elemento do topo da pilha.
  * \return elemento do topo da pilha.
  */
-template <typename T>
-T LinkedStack<T>::pop() {
+template <typename T, typename Alloc>
+T LinkedStack<T, Alloc>::pop() {
   Node* popped = top_;
   if (empty()) {
     throw std::out_of_range("Pilha vazia");
   } else {
-    T output = top_->data();
+    T output(std::move(top_->data()));
     top_ = top_->next();
     size_--;
-    delete popped;
+    delete_node(popped);
     return output;
   }
 }
@@ -103,8 +228,8 @@ T LinkedStack<T>::pop() {
  * Retorna o membro do topo da pilha.
  *\return referência do membro do topo.
  */
-template <typename T>
-T& LinkedStack<T>::top() const {
+template <typename T, typename Alloc>
+T& LinkedStack<T, Alloc>::top() const {
   if (empty()) {
     throw std::out_of_range("Pilha vazia");
   } else {
@@ -112,28 +237,53 @@ T& LinkedStack<T>::top() const {
   }
 }
 /**
- * Limpa a pilha.
+ * Limpa a pilha. Os nodos são destruídos sem copiar os dados; com um
+ * PoolAllocator o pool inteiro é devolvido de uma vez.
  */
-template <typename T>
-void LinkedStack<T>::clear() {
-  while (!empty()) {
-    pop();
+template <typename T, typename Alloc>
+void LinkedStack<T, Alloc>::clear() {
+  bool bulk = BulkRelease<NodeAlloc>::available(node_alloc_);
+  if (!bulk || !std::is_trivially_destructible<T>::value) {
+    Node* current = top_;
+    for (std::size_t i = 0; i < size_; i++) {
+      Node* next = current->next();
+      if (bulk) {
+        NodeTraits::destroy(node_alloc_, current);
+      } else {
+        delete_node(current);
+      }
+      current = next;
+    }
+  }
+  if (bulk) {
+    BulkRelease<NodeAlloc>::release(node_alloc_);
   }
+  top_ = nullptr;
+  size_ = 0;
+}
+/**
+ * Troca o conteúdo de duas pilhas em O(1).
+ */
+template <typename T, typename Alloc>
+void LinkedStack<T, Alloc>::swap(LinkedStack& other) {
+  std::swap(top_, other.top_);
+  std::swap(size_, other.size_);
+  std::swap(node_alloc_, other.node_alloc_);
 }
 /**
  * Retorna o tamanho da pilha.
  * \return tamanho da pilha.
  */
-template <typename T>
-std::size_t LinkedStack<T>::size() const {
+template <typename T, typename Alloc>
+std::size_t LinkedStack<T, Alloc>::size() const {
   return size_;
 }
 /**
  * Verifica se a pilha está vazia.
  *\return booleano
  */
-template <typename T>
-bool LinkedStack<T>::empty() const {
+template <typename T, typename Alloc>
+bool LinkedStack<T, Alloc>::empty() const {
   return size_ == 0;
 }
 }  // namespace structures
@@ -5,10 +5,15 @@
 
 #include <cstdint>  // std::size_t
 #include <stdexcept>  // C++ Exceptions
+#include <utility>  // std::forward, std::move, std::swap
 
 namespace structures {
 /**
  * Implementação de uma fila com template, (FIFO).
+ *
+ * Os elementos ficam em um buffer circular cuja capacidade é potência de dois;
+ * os índices dão a volta no buffer, então a fila pode ser usada
+ * indefinidamente sem realocação.
  */
 template<typename T>
 class ArrayQueue {
@@ -17,10 +22,25 @@ class ArrayQueue {
 
     explicit ArrayQueue(std::size_t max);
 
+    ArrayQueue(const ArrayQueue& other);
+
+    ArrayQueue(ArrayQueue&& other);
+
+    ArrayQueue& operator=(const ArrayQueue& other);
+
+    ArrayQueue& operator=(ArrayQueue&& other);
+
     ~ArrayQueue();
 
+    void swap(ArrayQueue& other);
+
     void enqueue(const T& data);
 
+    void enqueue(T&& data);
+
+    template<typename... Args>
+    void emplace(Args&&... args);
+
     T dequeue();
 
     T& back();
@@ -36,12 +56,29 @@ class ArrayQueue {
     bool full();
 
  private:
-    T* contents;  // Armazena os dados da fila.
+    static std::size_t capacity_for(std::size_t max);
+
+    T* contents;  // Armazena os dados da fila (buffer circular).
     std::size_t size_;  // Guarda o tamanho atual da fila.
     std::size_t max_size_;  // Guarda o tamanho máximo da fila.
-    int last_, first_;  // Variáveis para o último e primeiro elementos.
+    std::size_t mask_;  // Capacidade do buffer menos um (potência de dois).
+    std::size_t last_, first_;  // Índices do último e primeiro elementos.
     static const auto DEFAULT_SIZE = 10u;  // Guarda o tamanho padrão da fila.
 };
+/**
+ * Calcula a capacidade do buffer: a menor potência de dois que comporta max
+ * elementos, permitindo trocar o módulo por uma máscara de bits.
+ * \param max tamanho máximo pedido.
+ * \return capacidade do buffer.
+ */
+template<typename T>
+std::size_t ArrayQueue<T>::capacity_for(std::size_t max) {
+	std::size_t capacity = 1;
+	while (capacity < max) {
+		capacity <<= 1;
+	}
+	return capacity;
+}
 /**
  * Construtor. Determina o valor dos atributos na criação do objeto caso não haja parâmetros.
  */
@@ -49,8 +86,9 @@ template<typename T>
 ArrayQueue<T>::ArrayQueue() {
 	max_size_ = DEFAULT_SIZE;
 	size_ = 0;
-	contents = new T[max_size];
-	last_ = -1;
+	mask_ = capacity_for(max_size_) - 1;
+	contents = new T[mask_ + 1];
+	last_ = mask_;
 	first_ = 0;
 }
 /**
@@ -60,10 +98,68 @@ template<typename T>
 ArrayQueue<T>::ArrayQueue(std::size_t max) {
 	max_size_ = max;
 	size_ = 0;
-	contents = new T[max_size_];
-	last_ = -1;
+	mask_ = capacity_for(max_size_) - 1;
+	contents = new T[mask_ + 1];
+	last_ = mask_;
 	first_ = 0;
 }
+/**
+ * Construtor de cópia. Uma única alocação; os elementos vivos são copiados
+ * já desenrolados, a partir da posição zero.
+ */
+template<typename T>
+ArrayQueue<T>::ArrayQueue(const ArrayQueue& other) {
+	max_size_ = other.max_size_;
+	size_ = other.size_;
+	mask_ = other.mask_;
+	contents = new T[mask_ + 1];
+	try {
+		for (std::size_t i = 0; i < size_; i++) {
+			contents[i] = other.contents[(other.first_ + i) & mask_];
+		}
+	} catch (...) {
+		delete[] contents;
+		throw;
+	}
+	first_ = 0;
+	last_ = (size_ + mask_) & mask_;
+}
+/**
+ * Construtor de movimento. Toma o buffer de other, que fica sem capacidade.
+ */
+template<typename T>
+ArrayQueue<T>::ArrayQueue(ArrayQueue&& other) {
+	max_size_ = other.max_size_;
+	size_ = other.size_;
+	mask_ = other.mask_;
+	contents = other.contents;
+	last_ = other.last_;
+	first_ = other.first_;
+	other.contents = nullptr;
+	other.max_size_ = 0;
+	other.size_ = 0;
+	other.mask_ = 0;
+	other.last_ = 0;
+	other.first_ = 0;
+}
+/**
+ * Atribuição por cópia.
+ */
+template<typename T>
+ArrayQueue<T>& ArrayQueue<T>::operator=(const ArrayQueue& other) {
+	ArrayQueue copy(other);
+	swap(copy);
+	return *this;
+}
+/**
+ * Atribuição por movimento.
+ */
+template<typename T>
+ArrayQueue<T>& ArrayQueue<T>::operator=(ArrayQueue&& other) {
+	ArrayQueue moved(std::move(other));
+	swap(moved);
+	return *this;
+}
 /**
  * Destrutor. Deleta o array contents.
  */
@@ -71,6 +167,18 @@ template<typename T>
 ArrayQueue<T>::~ArrayQueue() {
     delete[] contents;
 }
+/**
+ * Troca o conteúdo de duas filas sem copiar elementos.
+ */
+template<typename T>
+void ArrayQueue<T>::swap(ArrayQueue& other) {
+	std::swap(contents, other.contents);
+	std::swap(size_, other.size_);
+	std::swap(max_size_, other.max_size_);
+	std::swap(mask_, other.mask_);
+	std::swap(last_, other.last_);
+	std::swap(first_, other.first_);
+}
 /**
  * Coloca um elemento no fim da fila.
  * \param referência de um dado.
@@ -81,9 +189,39 @@ void ArrayQueue<T>::enqueue(const T& data) {
 		throw std::out_of_range("Fila cheia");
 	}
 	size_++;
-	last_++;
+	last_ = (last_ + 1) & mask_;
 	contents[last_] = data;
 }
+/**
+ * Coloca um elemento no fim da fila, movendo-o.
+ * \param dado a ser movido.
+ */
+template<typename T>
+void ArrayQueue<T>::enqueue(T&& data) {
+	if (full()) {
+		throw std::out_of_range("Fila cheia");
+	}
+	std::size_t index = (last_ + 1) & mask_;
+	contents[index] = std::move(data);
+	last_ = index;
+	size_++;
+}
+/**
+ * Constrói um elemento a partir dos argumentos e o move para o fim da fila.
+ * As posições do buffer já existem, então o valor é atribuído a uma delas.
+ * \param argumentos do construtor de T.
+ */
+template<typename T>
+template<typename... Args>
+void ArrayQueue<T>::emplace(Args&&... args) {
+	if (full()) {
+		throw std::out_of_range("Fila cheia");
+	}
+	std::size_t index = (last_ + 1) & mask_;
+	contents[index] = T(std::forward<Args>(args)...);
+	last_ = index;
+	size_++;
+}
 /**
  * Retira o elemento do começo da fila.
  * \return elemento do começo da fila.
@@ -93,9 +231,10 @@ T ArrayQueue<T>::dequeue() {
 	if(empty()) {
 		throw std::out_of_range("Fila vazia");
 	}
+	std::size_t index = first_;
 	size_--;
-	first_++;
-	return contents[first_-1];
+	first_ = (first_ + 1) & mask_;
+	return std::move(contents[index]);
 }
 /**
  * Retorna o membro do fim da fila.
@@ -115,7 +254,7 @@ template<typename T>
 void ArrayQueue<T>::clear() {
 	size_ = 0;
 	first_ = 0;
-	last_ = -1;
+	last_ = mask_;
 }
 /**
  * Retorna o tamanho da fila.
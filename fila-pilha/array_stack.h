@@ -5,6 +5,7 @@
 
 #include <cstdint>
 #include <stdexcept>
+#include <utility>  // std::forward, std::move, std::swap
 
 namespace structures {
 /**
@@ -17,10 +18,25 @@ class ArrayStack {
 
     explicit ArrayStack(std::size_t max);
 
+    ArrayStack(const ArrayStack& other);
+
+    ArrayStack(ArrayStack&& other);
+
+    ArrayStack& operator=(const ArrayStack& other);
+
+    ArrayStack& operator=(ArrayStack&& other);
+
     ~ArrayStack();
 
+    void swap(ArrayStack& other);
+
     void push(const T& data);
 
+    void push(T&& data);
+
+    template<typename... Args>
+    void emplace(Args&&... args);
+
     T pop();
 
     T& top();
@@ -47,7 +63,7 @@ class ArrayStack {
 template<typename T>
 ArrayStack<T>::ArrayStack() {
 	max_size_ = DEFAULT_SIZE;
-	contents = new T[max_size];
+	contents = new T[max_size_];
 	top_ = -1;
 }
 /**
@@ -59,6 +75,54 @@ ArrayStack<T>::ArrayStack(std::size_t max) {
 	contents = new T[max_size_];
 	top_ = -1;
 }
+/**
+ * Construtor de cópia. Uma única alocação; só os elementos empilhados são
+ * copiados.
+ */
+template<typename T>
+ArrayStack<T>::ArrayStack(const ArrayStack& other) {
+	max_size_ = other.max_size_;
+	contents = new T[max_size_];
+	top_ = other.top_;
+	try {
+		for (int i = 0; i <= top_; i++) {
+			contents[i] = other.contents[i];
+		}
+	} catch (...) {
+		delete[] contents;
+		throw;
+	}
+}
+/**
+ * Construtor de movimento. Toma o array de other, que fica sem capacidade.
+ */
+template<typename T>
+ArrayStack<T>::ArrayStack(ArrayStack&& other) {
+	max_size_ = other.max_size_;
+	contents = other.contents;
+	top_ = other.top_;
+	other.contents = nullptr;
+	other.max_size_ = 0;
+	other.top_ = -1;
+}
+/**
+ * Atribuição por cópia.
+ */
+template<typename T>
+ArrayStack<T>& ArrayStack<T>::operator=(const ArrayStack& other) {
+	ArrayStack copy(other);
+	swap(copy);
+	return *this;
+}
+/**
+ * Atribuição por movimento.
+ */
+template<typename T>
+ArrayStack<T>& ArrayStack<T>::operator=(ArrayStack&& other) {
+	ArrayStack moved(std::move(other));
+	swap(moved);
+	return *this;
+}
 /**
  * Destrutor. Deleta o array contents.
  */
@@ -66,6 +130,15 @@ template<typename T>
 ArrayStack<T>::~ArrayStack() {
     delete[] contents;
 }
+/**
+ * Troca o conteúdo de duas pilhas sem copiar elementos.
+ */
+template<typename T>
+void ArrayStack<T>::swap(ArrayStack& other) {
+	std::swap(contents, other.contents);
+	std::swap(top_, other.top_);
+	std::swap(max_size_, other.max_size_);
+}
 /**
  * Coloca um elemento no topo da pilha.
  * \param referência de um dado.
@@ -78,6 +151,32 @@ void ArrayStack<T>::push(const T& data) {
 	top_++;
 	contents[top_] = data;
 }
+/**
+ * Coloca um elemento no topo da pilha, movendo-o.
+ * \param dado a ser movido.
+ */
+template<typename T>
+void ArrayStack<T>::push(T&& data) {
+	if(full()) {
+		throw std::out_of_range("Pilha cheia");
+	}
+	top_++;
+	contents[top_] = std::move(data);
+}
+/**
+ * Constrói um elemento a partir dos argumentos e o move para o topo. As
+ * posições do array já existem, então o valor é atribuído a uma delas.
+ * \param argumentos do construtor de T.
+ */
+template<typename T>
+template<typename... Args>
+void ArrayStack<T>::emplace(Args&&... args) {
+	if(full()) {
+		throw std::out_of_range("Pilha cheia");
+	}
+	contents[top_ + 1] = T(std::forward<Args>(args)...);
+	top_++;
+}
 /**
  * Retira o elemento do topo da pilha.
  * \return elemento do topo da pilha.
@@ -88,7 +187,7 @@ T ArrayStack<T>::pop() {
 		throw std::out_of_range("Pilha vazia");
 	}
 	top_--;
-	return contents[top_+1];
+	return std::move(contents[top_+1]);
 }
 /**
  * Retorna o membro do topo da pilha.
@@ -0,0 +1,396 @@
+// Copyright 2017 Eduardo Kohler
+
+#ifndef STRUCTURES_BLOCKING_QUEUE_H
+#define STRUCTURES_BLOCKING_QUEUE_H
+
+#include <atomic>  // std::atomic
+#include <chrono>  // std::chrono::duration, std::chrono::steady_clock
+#include <condition_variable>  // std::condition_variable
+#include <cstdint>  // std::size_t
+#include <mutex>  // std::mutex, std::unique_lock
+#include <utility>  // std::move
+
+#include "./array_queue.h"
+
+namespace structures {
+/**
+ * Fila (FIFO) limitada e bloqueante para produtores e consumidores, sobre
+ * uma ArrayQueue protegida por um mutex.
+ *
+ * push_wait espera por espaço e pop_wait espera por um elemento, em vez de
+ * girar em full()/empty() ou capturar std::out_of_range. try_pop_for
+ * desiste após um tempo. Depois de close(), inserções falham e as retiradas
+ * esvaziam o que restou, retornando false só com a fila vazia.
+ *
+ * Antes de dormir, quem espera gira um pouco lendo uma cópia atômica do
+ * tamanho, o que evita a ida ao núcleo quando o outro lado responde logo.
+ * Cada lado conta quantos estão dormindo: a notificação é pulada quando
+ * ninguém espera, e push_all e pop_some acordam de uma vez tantos quantos
+ * puderem ser atendidos.
+ */
+template<typename T>
+class BlockingQueue {
+ public:
+    BlockingQueue();
+
+    explicit BlockingQueue(std::size_t max);
+
+    BlockingQueue(const BlockingQueue&) = delete;
+
+    BlockingQueue& operator=(const BlockingQueue&) = delete;
+
+    bool push_wait(const T& data);  // espera por espaço
+
+    bool push_wait(T&& data);  // espera por espaço (mov.)
+
+    bool try_push(const T& data);  // não espera
+
+    template<typename InputIt>
+    InputIt push_all(InputIt first, InputIt last);  // insere em lotes
+
+    bool pop_wait(T& data);  // espera por um elemento
+
+    bool try_pop(T& data);  // não espera
+
+    template<typename Rep, typename Period>
+    bool try_pop_for(T& data,
+                     const std::chrono::duration<Rep, Period>& timeout);
+
+    template<typename OutputIt>
+    std::size_t pop_some(OutputIt out, std::size_t max);  // retira em lote
+
+    void close();
+
+    bool closed() const;
+
+    std::size_t size() const;
+
+    std::size_t max_size() const;
+
+    bool empty() const;
+
+    bool full() const;
+
+ private:
+    template<typename U>
+    bool push(U&& data);
+
+    template<typename Ready>
+    static bool spin(Ready ready);
+
+    static void wake(std::condition_variable& waiting, std::size_t sleepers,
+                     std::size_t count);
+
+    static const auto DEFAULT_SIZE = 10u;  // Guarda o tamanho padrão da fila.
+    static const auto SPIN_LIMIT = 256u;  // Leituras antes de dormir.
+
+    ArrayQueue<T> queue_;  // Elementos, acessados só com mutex_.
+    std::size_t max_size_;  // Guarda o tamanho máximo da fila.
+    mutable std::mutex mutex_;
+    std::condition_variable not_empty_;  // Consumidores esperando.
+    std::condition_variable not_full_;  // Produtores esperando.
+    std::size_t consumers_{0};  // Consumidores dormindo.
+    std::size_t producers_{0};  // Produtores dormindo.
+    std::atomic<std::size_t> size_{0};  // Cópia do tamanho para girar.
+    std::atomic<bool> closed_{false};
+};
+/**
+ * Construtor. Determina o valor dos atributos na criação do objeto caso não haja parâmetros.
+ */
+template<typename T>
+BlockingQueue<T>::BlockingQueue() :
+	BlockingQueue(DEFAULT_SIZE)
+{}
+/**
+ * Construtor. Usa o parâmetro passado como tamanho máximo.
+ */
+template<typename T>
+BlockingQueue<T>::BlockingQueue(std::size_t max) :
+	queue_(max),
+	max_size_{max}
+{}
+/**
+ * Coloca um elemento no fim da fila, esperando por espaço.
+ * \param data referência de um dado.
+ * \return false se a fila foi fechada.
+ */
+template<typename T>
+bool BlockingQueue<T>::push_wait(const T& data) {
+	return push(data);
+}
+/**
+ * Coloca um elemento no fim da fila, movendo-o, esperando por espaço.
+ * \param data dado a ser movido.
+ * \return false se a fila foi fechada.
+ */
+template<typename T>
+bool BlockingQueue<T>::push_wait(T&& data) {
+	return push(std::move(data));
+}
+/**
+ * Tenta colocar um elemento no fim da fila sem esperar.
+ * \param data referência de um dado.
+ * \return false se a fila estiver cheia ou fechada.
+ */
+template<typename T>
+bool BlockingQueue<T>::try_push(const T& data) {
+	std::unique_lock<std::mutex> lock(mutex_);
+	if (closed_.load(std::memory_order_relaxed) || queue_.full()) {
+		return false;
+	}
+	queue_.enqueue(data);
+	size_.store(queue_.size(), std::memory_order_relaxed);
+	std::size_t sleepers = consumers_;
+	lock.unlock();
+	wake(not_empty_, sleepers, 1);
+	return true;
+}
+/**
+ * Coloca os elementos de [first, last) no fim da fila, em ordem. A cada
+ * vez que há espaço, insere o quanto couber com uma só aquisição do mutex
+ * e acorda de uma vez os consumidores que podem ser atendidos.
+ * \param first início da sequência;
+ * \param last fim da sequência.
+ * \return posição do primeiro elemento não inserido (last, a menos que a
+ * fila tenha sido fechada).
+ */
+template<typename T>
+template<typename InputIt>
+InputIt BlockingQueue<T>::push_all(InputIt first, InputIt last) {
+	while (first != last) {
+		spin([this] {
+			return size_.load(std::memory_order_relaxed) < max_size_ ||
+			       closed_.load(std::memory_order_relaxed);
+		});
+		std::unique_lock<std::mutex> lock(mutex_);
+		while (queue_.full() && !closed_.load(std::memory_order_relaxed)) {
+			producers_++;
+			not_full_.wait(lock);
+			producers_--;
+		}
+		if (closed_.load(std::memory_order_relaxed)) {
+			break;
+		}
+		std::size_t pushed = 0;
+		for (; first != last && !queue_.full(); ++first, pushed++) {
+			queue_.enqueue(*first);
+		}
+		size_.store(queue_.size(), std::memory_order_relaxed);
+		std::size_t sleepers = consumers_;
+		lock.unlock();
+		wake(not_empty_, sleepers, pushed);
+	}
+	return first;
+}
+/**
+ * Retira o elemento do começo da fila, esperando por um.
+ * \param data recebe o elemento retirado.
+ * \return false se a fila foi fechada e está vazia.
+ */
+template<typename T>
+bool BlockingQueue<T>::pop_wait(T& data) {
+	return pop_some(&data, 1) == 1;
+}
+/**
+ * Tenta retirar o elemento do começo da fila sem esperar.
+ * \param data recebe o elemento retirado.
+ * \return false se a fila estiver vazia.
+ */
+template<typename T>
+bool BlockingQueue<T>::try_pop(T& data) {
+	std::unique_lock<std::mutex> lock(mutex_);
+	if (queue_.empty()) {
+		return false;
+	}
+	data = queue_.dequeue();
+	size_.store(queue_.size(), std::memory_order_relaxed);
+	std::size_t sleepers = producers_;
+	lock.unlock();
+	wake(not_full_, sleepers, 1);
+	return true;
+}
+/**
+ * Retira o elemento do começo da fila, esperando no máximo timeout.
+ * \param data recebe o elemento retirado;
+ * \param timeout tempo máximo de espera.
+ * \return false se o tempo acabou, ou se a fila foi fechada e está vazia.
+ */
+template<typename T>
+template<typename Rep, typename Period>
+bool BlockingQueue<T>::try_pop_for(
+		T& data, const std::chrono::duration<Rep, Period>& timeout) {
+	auto deadline = std::chrono::steady_clock::now() + timeout;
+	spin([this] {
+		return size_.load(std::memory_order_relaxed) > 0 ||
+		       closed_.load(std::memory_order_relaxed);
+	});
+	std::unique_lock<std::mutex> lock(mutex_);
+	while (queue_.empty() && !closed_.load(std::memory_order_relaxed)) {
+		consumers_++;
+		std::cv_status status = not_empty_.wait_until(lock, deadline);
+		consumers_--;
+		if (status == std::cv_status::timeout) {
+			break;
+		}
+	}
+	if (queue_.empty()) {
+		return false;
+	}
+	data = queue_.dequeue();
+	size_.store(queue_.size(), std::memory_order_relaxed);
+	std::size_t sleepers = producers_;
+	lock.unlock();
+	wake(not_full_, sleepers, 1);
+	return true;
+}
+/**
+ * Espera por ao menos um elemento e retira até max deles com uma só
+ * aquisição do mutex, acordando de uma vez os produtores que podem ser
+ * atendidos.
+ * \param out destino dos elementos retirados, em ordem;
+ * \param max número máximo de elementos.
+ * \return número de elementos retirados (0 só se a fila foi fechada e
+ * está vazia).
+ */
+template<typename T>
+template<typename OutputIt>
+std::size_t BlockingQueue<T>::pop_some(OutputIt out, std::size_t max) {
+	if (max == 0) {
+		return 0;
+	}
+	spin([this] {
+		return size_.load(std::memory_order_relaxed) > 0 ||
+		       closed_.load(std::memory_order_relaxed);
+	});
+	std::unique_lock<std::mutex> lock(mutex_);
+	while (queue_.empty() && !closed_.load(std::memory_order_relaxed)) {
+		consumers_++;
+		not_empty_.wait(lock);
+		consumers_--;
+	}
+	std::size_t popped = 0;
+	for (; popped < max && !queue_.empty(); popped++) {
+		*out = queue_.dequeue();
+		++out;
+	}
+	size_.store(queue_.size(), std::memory_order_relaxed);
+	std::size_t sleepers = producers_;
+	lock.unlock();
+	wake(not_full_, sleepers, popped);
+	return popped;
+}
+/**
+ * Fecha a fila e acorda todos que esperam. Inserções passam a falhar; os
+ * elementos restantes ainda podem ser retirados.
+ */
+template<typename T>
+void BlockingQueue<T>::close() {
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		closed_.store(true, std::memory_order_relaxed);
+	}
+	not_empty_.notify_all();
+	not_full_.notify_all();
+}
+/**
+ * Verifica se a fila foi fechada.
+ * \return booleano
+ */
+template<typename T>
+bool BlockingQueue<T>::closed() const {
+	return closed_.load(std::memory_order_relaxed);
+}
+/**
+ * Retorna o tamanho da fila. Com outras threads ativas o valor é apenas
+ * aproximado.
+ * \return tamanho da fila.
+ */
+template<typename T>
+std::size_t BlockingQueue<T>::size() const {
+	return size_.load(std::memory_order_relaxed);
+}
+/**
+ * Retorna o tamanho máximo da fila.
+ * \return tamanho máximo da fila.
+ */
+template<typename T>
+std::size_t BlockingQueue<T>::max_size() const {
+	return max_size_;
+}
+/**
+ * Verifica se a fila está vazia.
+ * \return booleano
+ */
+template<typename T>
+bool BlockingQueue<T>::empty() const {
+	return size() == 0;
+}
+/**
+ * Verifica se a fila está cheia.
+ * \return booleano
+ */
+template<typename T>
+bool BlockingQueue<T>::full() const {
+	return size() >= max_size_;
+}
+/**
+ * Coloca um elemento no fim da fila, esperando por espaço.
+ */
+template<typename T>
+template<typename U>
+bool BlockingQueue<T>::push(U&& data) {
+	spin([this] {
+		return size_.load(std::memory_order_relaxed) < max_size_ ||
+		       closed_.load(std::memory_order_relaxed);
+	});
+	std::unique_lock<std::mutex> lock(mutex_);
+	while (queue_.full() && !closed_.load(std::memory_order_relaxed)) {
+		producers_++;
+		not_full_.wait(lock);
+		producers_--;
+	}
+	if (closed_.load(std::memory_order_relaxed)) {
+		return false;
+	}
+	queue_.enqueue(std::forward<U>(data));
+	size_.store(queue_.size(), std::memory_order_relaxed);
+	std::size_t sleepers = consumers_;
+	lock.unlock();
+	wake(not_empty_, sleepers, 1);
+	return true;
+}
+/**
+ * Gira lendo ready() até que seja verdadeiro ou o limite acabe.
+ * \return o último valor de ready().
+ */
+template<typename T>
+template<typename Ready>
+bool BlockingQueue<T>::spin(Ready ready) {
+	for (std::size_t i = 0; i < SPIN_LIMIT; i++) {
+		if (ready()) {
+			return true;
+		}
+	}
+	return ready();
+}
+/**
+ * Acorda até count threads de uma variável de condição, sabendo quantas
+ * dormiam; com count suficiente, acorda todas de uma vez.
+ */
+template<typename T>
+void BlockingQueue<T>::wake(std::condition_variable& waiting,
+                            std::size_t sleepers, std::size_t count) {
+	if (sleepers == 0 || count == 0) {
+		return;
+	}
+	if (count >= sleepers) {
+		waiting.notify_all();
+		return;
+	}
+	for (std::size_t i = 0; i < count; i++) {
+		waiting.notify_one();
+	}
+}
+}  // namespace structures
+
+#endif
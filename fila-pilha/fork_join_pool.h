@@ -0,0 +1,348 @@
+// Copyright 2017 Eduardo Kohler
+
+#ifndef STRUCTURES_FORK_JOIN_POOL_H
+#define STRUCTURES_FORK_JOIN_POOL_H
+
+#include <atomic>  // std::atomic
+#include <condition_variable>  // std::condition_variable
+#include <cstdint>  // std::size_t, std::uint64_t
+#include <deque>  // std::deque
+#include <exception>  // std::exception_ptr
+#include <functional>  // std::function
+#include <memory>  // std::unique_ptr
+#include <mutex>  // std::mutex, std::lock_guard, std::unique_lock
+#include <thread>  // std::thread
+#include <utility>  // std::forward, std::move
+#include <vector>  // std::vector
+
+#include "./work_stealing_deque.h"
+
+namespace structures {
+/**
+ * Pool de threads fork-join com roubo de trabalho.
+ *
+ * Cada worker tem uma WorkStealingDeque de tarefas: o que ele cria vai para
+ * a base da própria deque e é executado em ordem LIFO (perto do que já está
+ * na cache), e um worker sem trabalho rouba do topo da deque de outro,
+ * escolhido ao acaso, pegando as tarefas mais antigas (em geral as maiores).
+ * Tarefas criadas fora do pool entram em uma fila de injeção.
+ *
+ * Tarefas são agrupadas em um Group; wait() espera todas as tarefas do
+ * grupo. Dentro de um worker, wait() executa outras tarefas enquanto espera,
+ * então recursões como fib(n - 1) + fib(n - 2) não bloqueiam threads. A
+ * primeira exceção lançada por uma tarefa do grupo é relançada por wait().
+ * Workers sem trabalho dormem em uma variável de condição.
+ */
+class ForkJoinPool {
+ public:
+    class Group;
+
+    explicit ForkJoinPool(std::size_t threads = 0);
+
+    ForkJoinPool(const ForkJoinPool&) = delete;
+
+    ForkJoinPool& operator=(const ForkJoinPool&) = delete;
+
+    ~ForkJoinPool();
+
+    template<typename F>
+    void invoke(F&& work);  // executa work no pool e espera
+
+    std::size_t size() const;
+
+ private:
+    struct Task {
+        std::function<void()> work;
+        Group* group;
+    };
+
+    struct Worker {
+        WorkStealingDeque<Task*> tasks;
+        ForkJoinPool* pool;  // Pool ao qual o worker pertence.
+        std::uint64_t seed;  // Estado do xorshift para escolher vítimas.
+    };
+
+    static Worker*& current_worker();
+    Worker* local_worker() const;
+
+    void submit(Task* task);
+    Task* find_task(Worker* self);
+    void execute(Task* task);
+    void run(std::size_t index);
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::vector<std::thread> threads_;
+    std::mutex mutex_;  // Protege injected_ e a espera dos workers.
+    std::condition_variable wake_;
+    std::deque<Task*> injected_;  // Tarefas vindas de fora do pool.
+    std::atomic<std::size_t> queued_{0};  // Tarefas ainda não retiradas.
+    std::atomic<std::size_t> sleeping_{0};  // Workers dormindo.
+    std::atomic<bool> stop_{false};
+};
+/**
+ * Conjunto de tarefas de um pool esperadas juntas.
+ */
+class ForkJoinPool::Group {
+ public:
+    explicit Group(ForkJoinPool& pool);
+
+    Group(const Group&) = delete;
+
+    Group& operator=(const Group&) = delete;
+
+    ~Group();
+
+    template<typename F>
+    void spawn(F&& work);  // cria uma tarefa no grupo
+
+    void wait();  // espera as tarefas do grupo
+
+ private:
+    friend class ForkJoinPool;
+
+    void finish(std::exception_ptr error);
+
+    ForkJoinPool& pool_;
+    std::atomic<std::size_t> pending_{0};  // Tarefas não terminadas.
+    std::mutex mutex_;  // Protege error_ e a espera fora do pool.
+    std::condition_variable done_;
+    std::exception_ptr error_;  // Primeira exceção de uma tarefa.
+};
+/**
+ * Construtor. Cria os workers.
+ * \param threads número de workers (0 usa o número de núcleos).
+ */
+inline ForkJoinPool::ForkJoinPool(std::size_t threads) {
+	if (threads == 0) {
+		threads = std::thread::hardware_concurrency();
+		if (threads == 0) {
+			threads = 1;
+		}
+	}
+	for (std::size_t i = 0; i < threads; i++) {
+		workers_.emplace_back(new Worker());
+		workers_.back()->pool = this;
+		workers_.back()->seed = 0x9E3779B97F4A7C15u * (i + 1);
+	}
+	for (std::size_t i = 0; i < threads; i++) {
+		threads_.emplace_back(&ForkJoinPool::run, this, i);
+	}
+}
+/**
+ * Destrutor. Espera os workers terminarem; tarefas que ainda não começaram
+ * são descartadas, então grupos devem ser esperados antes.
+ */
+inline ForkJoinPool::~ForkJoinPool() {
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		stop_.store(true);
+	}
+	wake_.notify_all();
+	for (auto& thread : threads_) {
+		thread.join();
+	}
+	Task* task;
+	for (auto& worker : workers_) {
+		while (worker->tasks.try_pop(task)) {
+			delete task;
+		}
+	}
+	for (Task* pending : injected_) {
+		delete pending;
+	}
+}
+/**
+ * Executa work em um worker e espera que termine, junto com as tarefas
+ * criadas por ela em grupos esperados.
+ * \param work função sem parâmetros.
+ */
+template<typename F>
+void ForkJoinPool::invoke(F&& work) {
+	Group group(*this);
+	group.spawn(std::forward<F>(work));
+	group.wait();
+}
+/**
+ * Retorna o número de workers.
+ */
+inline std::size_t ForkJoinPool::size() const {
+	return workers_.size();
+}
+/**
+ * Worker do pool que executa a thread atual (nullptr fora de um pool).
+ */
+inline ForkJoinPool::Worker*& ForkJoinPool::current_worker() {
+	static thread_local Worker* worker = nullptr;
+	return worker;
+}
+/**
+ * Worker deste pool que executa a thread atual, ou nullptr.
+ */
+inline ForkJoinPool::Worker* ForkJoinPool::local_worker() const {
+	Worker* worker = current_worker();
+	return worker != nullptr && worker->pool == this ? worker : nullptr;
+}
+/**
+ * Enfileira uma tarefa: na deque do worker atual, se ele for deste pool, ou
+ * na fila de injeção. Acorda um worker se algum estiver dormindo.
+ */
+inline void ForkJoinPool::submit(Task* task) {
+	Worker* self = local_worker();
+	queued_.fetch_add(1);  // antes de publicar, para não ficar negativo
+	if (self != nullptr) {
+		self->tasks.push(task);
+	} else {
+		std::lock_guard<std::mutex> lock(mutex_);
+		injected_.push_back(task);
+	}
+	if (sleeping_.load() > 0) {
+		std::lock_guard<std::mutex> lock(mutex_);
+		wake_.notify_one();
+	}
+}
+/**
+ * Procura uma tarefa: na própria deque, depois roubando de outro worker a
+ * partir de um escolhido ao acaso, e por fim na fila de injeção.
+ * \param self worker atual ou nullptr.
+ * \return tarefa retirada ou nullptr.
+ */
+inline ForkJoinPool::Task* ForkJoinPool::find_task(Worker* self) {
+	Task* task = nullptr;
+	if (self != nullptr && self->tasks.try_pop(task)) {
+		queued_.fetch_sub(1);
+		return task;
+	}
+	std::size_t count = workers_.size();
+	std::size_t start = 0;
+	if (self != nullptr) {
+		self->seed ^= self->seed << 13;
+		self->seed ^= self->seed >> 7;
+		self->seed ^= self->seed << 17;
+		start = static_cast<std::size_t>(self->seed % count);
+	}
+	for (std::size_t i = 0; i < count; i++) {
+		Worker* victim = workers_[(start + i) % count].get();
+		if (victim != self && victim->tasks.try_steal(task)) {
+			queued_.fetch_sub(1);
+			return task;
+		}
+	}
+	if (queued_.load() == 0) {
+		return nullptr;
+	}
+	std::lock_guard<std::mutex> lock(mutex_);
+	if (injected_.empty()) {
+		return nullptr;
+	}
+	task = injected_.front();
+	injected_.pop_front();
+	queued_.fetch_sub(1);
+	return task;
+}
+/**
+ * Executa uma tarefa e avisa o seu grupo.
+ */
+inline void ForkJoinPool::execute(Task* task) {
+	Group* group = task->group;
+	std::exception_ptr error;
+	try {
+		task->work();
+	} catch (...) {
+		error = std::current_exception();
+	}
+	delete task;
+	group->finish(error);
+}
+/**
+ * Laço de um worker: executa tarefas enquanto houver e dorme quando não há
+ * nenhuma enfileirada.
+ */
+inline void ForkJoinPool::run(std::size_t index) {
+	Worker* self = workers_[index].get();
+	current_worker() = self;
+	for (;;) {
+		Task* task = find_task(self);
+		if (task != nullptr) {
+			execute(task);
+			continue;
+		}
+		std::unique_lock<std::mutex> lock(mutex_);
+		sleeping_.fetch_add(1);
+		wake_.wait(lock, [this] {
+			return stop_.load() || queued_.load() > 0;
+		});
+		sleeping_.fetch_sub(1);
+		if (stop_.load()) {
+			return;
+		}
+	}
+}
+/**
+ * Construtor.
+ * \param pool pool que executa as tarefas do grupo.
+ */
+inline ForkJoinPool::Group::Group(ForkJoinPool& pool) :
+	pool_(pool)
+{}
+/**
+ * Destrutor. Espera as tarefas que ainda não terminaram.
+ */
+inline ForkJoinPool::Group::~Group() {
+	try {
+		wait();
+	} catch (...) {
+	}
+}
+/**
+ * Cria uma tarefa no grupo.
+ * \param work função sem parâmetros.
+ */
+template<typename F>
+void ForkJoinPool::Group::spawn(F&& work) {
+	std::unique_ptr<Task> task(new Task{std::forward<F>(work), this});
+	pending_.fetch_add(1);
+	pool_.submit(task.get());
+	task.release();
+}
+/**
+ * Espera todas as tarefas do grupo. Em um worker, executa outras tarefas
+ * enquanto isso; fora do pool, bloqueia.
+ * \throw a primeira exceção lançada por uma tarefa do grupo.
+ */
+inline void ForkJoinPool::Group::wait() {
+	Worker* self = pool_.local_worker();
+	if (self != nullptr) {
+		while (pending_.load(std::memory_order_acquire) > 0) {
+			Task* task = pool_.find_task(self);
+			if (task != nullptr) {
+				pool_.execute(task);
+			} else {
+				std::this_thread::yield();
+			}
+		}
+	}
+	std::unique_lock<std::mutex> lock(mutex_);
+	done_.wait(lock, [this] {
+		return pending_.load(std::memory_order_acquire) == 0;
+	});
+	if (error_) {
+		std::exception_ptr error = error_;
+		error_ = nullptr;
+		std::rethrow_exception(error);
+	}
+}
+/**
+ * Registra o fim de uma tarefa do grupo, guardando a primeira exceção.
+ */
+inline void ForkJoinPool::Group::finish(std::exception_ptr error) {
+	std::lock_guard<std::mutex> lock(mutex_);
+	if (error && !error_) {
+		error_ = error;
+	}
+	if (pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+		done_.notify_all();
+	}
+}
+}  // namespace structures
+
+#endif
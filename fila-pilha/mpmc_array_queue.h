@@ -0,0 +1,243 @@
+// Copyright 2017 Eduardo Kohler
+
+#ifndef STRUCTURES_MPMC_ARRAY_QUEUE_H
+#define STRUCTURES_MPMC_ARRAY_QUEUE_H
+
+#include <atomic>  // std::atomic
+#include <cstdint>  // std::size_t
+#include <stdexcept>  // C++ Exceptions
+
+namespace structures {
+/**
+ * Fila circular (FIFO) limitada para múltiplos produtores e múltiplos
+ * consumidores, no estilo de Vyukov.
+ *
+ * Cada posição do buffer tem um número de sequência que diz de quem é a vez:
+ * igual ao índice de escrita quando está livre para um produtor, e igual ao
+ * índice mais um quando guarda um dado pronto para um consumidor. Produtores
+ * e consumidores disputam apenas o próprio contador com CAS, e try_enqueue e
+ * try_dequeue nunca lançam exceção: retornam false com a fila cheia ou vazia.
+ *
+ * O buffer é arredondado para uma potência de dois (no mínimo 2), mas a
+ * fila fica cheia com max_size() elementos, como ArrayQueue e
+ * SpscArrayQueue.
+ */
+template<typename T>
+class MpmcArrayQueue {
+ public:
+    MpmcArrayQueue();
+
+    explicit MpmcArrayQueue(std::size_t max);
+
+    MpmcArrayQueue(const MpmcArrayQueue&) = delete;
+
+    MpmcArrayQueue& operator=(const MpmcArrayQueue&) = delete;
+
+    ~MpmcArrayQueue();
+
+    bool try_enqueue(const T& data);
+
+    bool try_dequeue(T& data);
+
+    void enqueue(const T& data);
+
+    T dequeue();
+
+    std::size_t size() const;
+
+    std::size_t max_size() const;
+
+    bool empty() const;
+
+    bool full() const;
+
+ private:
+    struct Cell {
+        std::atomic<std::size_t> sequence;  // Dono atual da posição.
+        T data;
+    };
+
+    static std::size_t capacity_for(std::size_t max);
+
+    static const std::size_t CACHE_LINE = 64;  // Tamanho de uma linha de cache.
+    static const auto DEFAULT_SIZE = 16u;  // Guarda o tamanho padrão da fila.
+
+    // Imutáveis, produtores e consumidores em linhas de cache distintas.
+    Cell* contents;  // Buffer circular.
+    std::size_t mask_;  // Capacidade do buffer menos um.
+    std::size_t max_size_;  // Guarda o tamanho máximo da fila.
+    char padding1_[CACHE_LINE - sizeof(Cell*) - 2 * sizeof(std::size_t)];
+    std::atomic<std::size_t> enqueue_pos_;  // Produtores.
+    char padding2_[CACHE_LINE - sizeof(std::atomic<std::size_t>)];
+    std::atomic<std::size_t> dequeue_pos_;  // Consumidores.
+};
+/**
+ * Calcula a capacidade do buffer: a menor potência de dois, a partir de 2,
+ * que comporta max elementos.
+ * \param max tamanho máximo pedido.
+ * \return capacidade do buffer.
+ */
+template<typename T>
+std::size_t MpmcArrayQueue<T>::capacity_for(std::size_t max) {
+	std::size_t capacity = 2;
+	while (capacity < max) {
+		capacity <<= 1;
+	}
+	return capacity;
+}
+/**
+ * Construtor. Determina o valor dos atributos na criação do objeto caso não haja parâmetros.
+ */
+template<typename T>
+MpmcArrayQueue<T>::MpmcArrayQueue() :
+	MpmcArrayQueue(DEFAULT_SIZE)
+{}
+/**
+ * Construtor. Usa o parâmetro passado como tamanho máximo e marca cada
+ * posição como livre para o produtor de mesmo índice.
+ */
+template<typename T>
+MpmcArrayQueue<T>::MpmcArrayQueue(std::size_t max) :
+	max_size_{max},
+	enqueue_pos_{0},
+	dequeue_pos_{0}
+{
+	mask_ = capacity_for(max) - 1;
+	contents = new Cell[mask_ + 1];
+	for (std::size_t i = 0; i <= mask_; i++) {
+		contents[i].sequence.store(i, std::memory_order_relaxed);
+	}
+}
+/**
+ * Destrutor. Deleta o array contents.
+ */
+template<typename T>
+MpmcArrayQueue<T>::~MpmcArrayQueue() {
+	delete[] contents;
+}
+/**
+ * Tenta colocar um elemento no fim da fila.
+ * \param data referência de um dado.
+ * \return false se a fila estiver cheia.
+ */
+template<typename T>
+bool MpmcArrayQueue<T>::try_enqueue(const T& data) {
+	Cell* cell;
+	std::size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+	for (;;) {
+		cell = &contents[pos & mask_];
+		std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+		auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+		if (diff == 0) {
+			// O buffer pode ter mais posições que max_size_. Se pos ficou
+			// para trás (já foi ocupada e até retirada), a conta não vale:
+			// relê enqueue_pos_ e tenta de novo.
+			std::size_t dequeued = dequeue_pos_.load(std::memory_order_acquire);
+			if (dequeued > pos || pos - dequeued >= max_size_) {
+				std::size_t current = enqueue_pos_.load(std::memory_order_relaxed);
+				if (current != pos) {
+					pos = current;
+					continue;
+				}
+				return false;
+			}
+			if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+				break;
+			}
+		} else if (diff < 0) {
+			return false;
+		} else {
+			pos = enqueue_pos_.load(std::memory_order_relaxed);
+		}
+	}
+	cell->data = data;
+	cell->sequence.store(pos + 1, std::memory_order_release);
+	return true;
+}
+/**
+ * Tenta retirar o elemento do começo da fila.
+ * \param data recebe o elemento retirado.
+ * \return false se a fila estiver vazia.
+ */
+template<typename T>
+bool MpmcArrayQueue<T>::try_dequeue(T& data) {
+	Cell* cell;
+	std::size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+	for (;;) {
+		cell = &contents[pos & mask_];
+		std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+		auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1);
+		if (diff == 0) {
+			if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+				break;
+			}
+		} else if (diff < 0) {
+			return false;
+		} else {
+			pos = dequeue_pos_.load(std::memory_order_relaxed);
+		}
+	}
+	data = cell->data;
+	cell->sequence.store(pos + mask_ + 1, std::memory_order_release);
+	return true;
+}
+/**
+ * Coloca um elemento no fim da fila.
+ * \param data referência de um dado.
+ */
+template<typename T>
+void MpmcArrayQueue<T>::enqueue(const T& data) {
+	if (!try_enqueue(data)) {
+		throw std::out_of_range("Fila cheia");
+	}
+}
+/**
+ * Retira o elemento do começo da fila.
+ * \return elemento do começo da fila.
+ */
+template<typename T>
+T MpmcArrayQueue<T>::dequeue() {
+	T output;
+	if (!try_dequeue(output)) {
+		throw std::out_of_range("Fila vazia");
+	}
+	return output;
+}
+/**
+ * Retorna o tamanho da fila. Com outras threads ativas o valor é apenas
+ * aproximado.
+ * \return tamanho da fila.
+ */
+template<typename T>
+std::size_t MpmcArrayQueue<T>::size() const {
+	std::size_t head = dequeue_pos_.load(std::memory_order_acquire);
+	std::size_t tail = enqueue_pos_.load(std::memory_order_acquire);
+	return tail > head ? tail - head : 0;
+}
+/**
+ * Retorna o tamanho máximo da fila.
+ * \return tamanho máximo da fila.
+ */
+template<typename T>
+std::size_t MpmcArrayQueue<T>::max_size() const {
+	return max_size_;
+}
+/**
+ * Verifica se a fila está vazia.
+ *\return booleano
+ */
+template<typename T>
+bool MpmcArrayQueue<T>::empty() const {
+	return size() == 0;
+}
+/**
+ * Verifica se a fila está cheia.
+ * \return booleano.
+ */
+template<typename T>
+bool MpmcArrayQueue<T>::full() const {
+	return size() >= max_size();
+}
+}  // namespace structures
+
+#endif
@@ -0,0 +1,212 @@
+// Copyright 2017 Eduardo Kohler
+
+#ifndef STRUCTURES_SPSC_ARRAY_QUEUE_H
+#define STRUCTURES_SPSC_ARRAY_QUEUE_H
+
+#include <atomic>  // std::atomic
+#include <cstdint>  // std::size_t
+#include <stdexcept>  // C++ Exceptions
+
+namespace structures {
+/**
+ * Fila circular (FIFO) sem travas para um único produtor e um único
+ * consumidor.
+ *
+ * Só o produtor escreve em tail_ e só o consumidor escreve em head_; cada
+ * índice é publicado com release e lido com acquire pelo outro lado. Os dois
+ * ficam em linhas de cache separadas, e cada lado guarda uma cópia local do
+ * índice do outro, relendo o atômico apenas quando a cópia indica fila cheia
+ * (produtor) ou vazia (consumidor).
+ */
+template<typename T>
+class SpscArrayQueue {
+ public:
+    SpscArrayQueue();
+
+    explicit SpscArrayQueue(std::size_t max);
+
+    SpscArrayQueue(const SpscArrayQueue&) = delete;
+
+    SpscArrayQueue& operator=(const SpscArrayQueue&) = delete;
+
+    ~SpscArrayQueue();
+
+    void enqueue(const T& data);  // somente o produtor
+
+    T dequeue();  // somente o consumidor
+
+    bool try_enqueue(const T& data);  // somente o produtor
+
+    bool try_dequeue(T& data);  // somente o consumidor
+
+    std::size_t size() const;
+
+    std::size_t max_size() const;
+
+    bool empty() const;
+
+    bool full() const;
+
+ private:
+    static std::size_t capacity_for(std::size_t max);
+
+    static const std::size_t CACHE_LINE = 64;  // Tamanho de uma linha de cache.
+    static const auto DEFAULT_SIZE = 10u;  // Guarda o tamanho padrão da fila.
+
+    // Grupos separados por preenchimento: com alignas a fila exigiria
+    // alinhamento estendido, que new não garante em C++11.
+
+    // Lado do consumidor.
+    std::atomic<std::size_t> head_;  // Próximo a sair.
+    std::size_t tail_cache_;  // Última tail_ vista pelo consumidor.
+    char padding1_[CACHE_LINE - 2 * sizeof(std::size_t)];
+
+    // Lado do produtor.
+    std::atomic<std::size_t> tail_;  // Próximo a entrar.
+    std::size_t head_cache_;  // Última head_ vista pelo produtor.
+    char padding2_[CACHE_LINE - 2 * sizeof(std::size_t)];
+
+    // Imutáveis após a construção.
+    T* contents;  // Buffer circular.
+    std::size_t max_size_;  // Guarda o tamanho máximo da fila.
+    std::size_t mask_;  // Capacidade do buffer menos um (potência de dois).
+};
+/**
+ * Calcula a capacidade do buffer: a menor potência de dois que comporta max
+ * elementos.
+ * \param max tamanho máximo pedido.
+ * \return capacidade do buffer.
+ */
+template<typename T>
+std::size_t SpscArrayQueue<T>::capacity_for(std::size_t max) {
+	std::size_t capacity = 1;
+	while (capacity < max) {
+		capacity <<= 1;
+	}
+	return capacity;
+}
+/**
+ * Construtor. Determina o valor dos atributos na criação do objeto caso não haja parâmetros.
+ */
+template<typename T>
+SpscArrayQueue<T>::SpscArrayQueue() :
+	SpscArrayQueue(DEFAULT_SIZE)
+{}
+/**
+ * Construtor. Determina o valor das variáveis e usa o parâmetro passado como tamanho máximo.
+ */
+template<typename T>
+SpscArrayQueue<T>::SpscArrayQueue(std::size_t max) :
+	head_{0},
+	tail_cache_{0},
+	tail_{0},
+	head_cache_{0},
+	max_size_{max}
+{
+	mask_ = capacity_for(max_size_) - 1;
+	contents = new T[mask_ + 1];
+}
+/**
+ * Destrutor. Deleta o array contents.
+ */
+template<typename T>
+SpscArrayQueue<T>::~SpscArrayQueue() {
+	delete[] contents;
+}
+/**
+ * Tenta colocar um elemento no fim da fila. Deve ser chamado apenas pela
+ * thread produtora.
+ * \param data referência de um dado.
+ * \return false se a fila estiver cheia.
+ */
+template<typename T>
+bool SpscArrayQueue<T>::try_enqueue(const T& data) {
+	std::size_t tail = tail_.load(std::memory_order_relaxed);
+	if (tail - head_cache_ == max_size_) {
+		head_cache_ = head_.load(std::memory_order_acquire);
+		if (tail - head_cache_ == max_size_) {
+			return false;
+		}
+	}
+	contents[tail & mask_] = data;
+	tail_.store(tail + 1, std::memory_order_release);
+	return true;
+}
+/**
+ * Tenta retirar o elemento do começo da fila. Deve ser chamado apenas pela
+ * thread consumidora.
+ * \param data recebe o elemento retirado.
+ * \return false se a fila estiver vazia.
+ */
+template<typename T>
+bool SpscArrayQueue<T>::try_dequeue(T& data) {
+	std::size_t head = head_.load(std::memory_order_relaxed);
+	if (head == tail_cache_) {
+		tail_cache_ = tail_.load(std::memory_order_acquire);
+		if (head == tail_cache_) {
+			return false;
+		}
+	}
+	data = contents[head & mask_];
+	head_.store(head + 1, std::memory_order_release);
+	return true;
+}
+/**
+ * Coloca um elemento no fim da fila.
+ * \param data referência de um dado.
+ */
+template<typename T>
+void SpscArrayQueue<T>::enqueue(const T& data) {
+	if (!try_enqueue(data)) {
+		throw std::out_of_range("Fila cheia");
+	}
+}
+/**
+ * Retira o elemento do começo da fila.
+ * \return elemento do começo da fila.
+ */
+template<typename T>
+T SpscArrayQueue<T>::dequeue() {
+	T output;
+	if (!try_dequeue(output)) {
+		throw std::out_of_range("Fila vazia");
+	}
+	return output;
+}
+/**
+ * Retorna o tamanho da fila. Com as duas threads ativas o valor é apenas
+ * um retrato do momento da leitura.
+ * \return tamanho da fila.
+ */
+template<typename T>
+std::size_t SpscArrayQueue<T>::size() const {
+	std::size_t head = head_.load(std::memory_order_acquire);
+	return tail_.load(std::memory_order_acquire) - head;
+}
+/**
+ * Retorna o tamanho máximo da fila.
+ * \return tamanho máximo da fila.
+ */
+template<typename T>
+std::size_t SpscArrayQueue<T>::max_size() const {
+	return max_size_;
+}
+/**
+ * Verifica se a fila está vazia.
+ *\return booleano
+ */
+template<typename T>
+bool SpscArrayQueue<T>::empty() const {
+	return size() == 0;
+}
+/**
+ * Verifica se a fila está cheia.
+ * \return booleano.
+ */
+template<typename T>
+bool SpscArrayQueue<T>::full() const {
+	return size() == max_size_;
+}
+}  // namespace structures
+
+#endif
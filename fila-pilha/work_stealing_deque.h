@@ -0,0 +1,256 @@
+// Copyright 2017 Eduardo Kohler
+
+#ifndef STRUCTURES_WORK_STEALING_DEQUE_H
+#define STRUCTURES_WORK_STEALING_DEQUE_H
+
+#include <atomic>  // std::atomic, std::atomic_thread_fence
+#include <cstdint>  // std::size_t, std::int64_t
+#include <type_traits>  // std::is_trivially_copyable
+
+namespace structures {
+/**
+ * Deque de roubo de trabalho (Chase–Lev) sobre um buffer circular que
+ * cresce.
+ *
+ * Só a thread dona usa a base (bottom_): push e try_pop trabalham nela como
+ * em uma ArrayStack (LIFO), sem CAS exceto quando resta um único elemento.
+ * As demais threads usam try_steal, que retira do topo (top_) como em uma
+ * ArrayQueue (FIFO) e disputa com CAS. As ordens de memória seguem a versão
+ * C11 de Lê, Pop, Cohen e Nardelli.
+ *
+ * Quando o buffer enche, a dona copia os elementos para um buffer com o
+ * dobro da capacidade. Um ladrão ainda pode estar lendo o buffer antigo,
+ * então ele só é liberado no destrutor (a soma dos antigos é menor que o
+ * atual). As posições são atômicas, por isso T deve ser trivialmente
+ * copiável (um ponteiro para a tarefa, por exemplo).
+ */
+template<typename T>
+class WorkStealingDeque {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "WorkStealingDeque exige T trivialmente copiável");
+
+ public:
+    WorkStealingDeque();
+
+    explicit WorkStealingDeque(std::size_t capacity);
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    ~WorkStealingDeque();
+
+    void push(const T& data);  // somente a dona
+
+    bool try_pop(T& data);  // somente a dona
+
+    bool try_steal(T& data);  // qualquer thread
+
+    std::size_t size() const;
+
+    std::size_t capacity() const;
+
+    bool empty() const;
+
+ private:
+    struct Buffer {
+        explicit Buffer(std::size_t capacity);
+
+        ~Buffer();
+
+        T get(std::int64_t index) const;
+
+        void put(std::int64_t index, const T& data);
+
+        std::size_t mask;  // Capacidade menos um (potência de dois).
+        std::atomic<T>* cells;  // Posições do buffer circular.
+        Buffer* previous{nullptr};  // Buffer substituído, liberado no fim.
+    };
+
+    Buffer* grow(Buffer* buffer, std::int64_t top, std::int64_t bottom);
+
+    static const std::size_t CACHE_LINE = 64;  // Tamanho de uma linha de cache.
+    static const auto DEFAULT_SIZE = 64u;  // Capacidade inicial padrão.
+
+    // Ladrões e dona em linhas de cache distintas.
+    std::atomic<std::int64_t> top_;  // Ladrões.
+    char padding_[CACHE_LINE - sizeof(std::atomic<std::int64_t>)];
+    std::atomic<std::int64_t> bottom_;  // Dona.
+    std::atomic<Buffer*> buffer_;  // Buffer atual, trocado só pela dona.
+};
+/**
+ * Construtor do buffer. Arredonda a capacidade para uma potência de dois.
+ */
+template<typename T>
+WorkStealingDeque<T>::Buffer::Buffer(std::size_t capacity) {
+	std::size_t size = 2;
+	while (size < capacity) {
+		size <<= 1;
+	}
+	mask = size - 1;
+	cells = new std::atomic<T>[size];
+}
+/**
+ * Destrutor do buffer. Libera também os buffers que ele substituiu.
+ */
+template<typename T>
+WorkStealingDeque<T>::Buffer::~Buffer() {
+	delete[] cells;
+	delete previous;
+}
+/**
+ * Lê a posição correspondente a um índice.
+ */
+template<typename T>
+T WorkStealingDeque<T>::Buffer::get(std::int64_t index) const {
+	return cells[static_cast<std::size_t>(index) & mask].load(
+		std::memory_order_relaxed);
+}
+/**
+ * Escreve na posição correspondente a um índice.
+ */
+template<typename T>
+void WorkStealingDeque<T>::Buffer::put(std::int64_t index, const T& data) {
+	cells[static_cast<std::size_t>(index) & mask].store(
+		data, std::memory_order_relaxed);
+}
+/**
+ * Construtor. Determina o valor dos atributos na criação do objeto caso não haja parâmetros.
+ */
+template<typename T>
+WorkStealingDeque<T>::WorkStealingDeque() :
+	WorkStealingDeque(DEFAULT_SIZE)
+{}
+/**
+ * Construtor. Usa o parâmetro passado como capacidade inicial.
+ */
+template<typename T>
+WorkStealingDeque<T>::WorkStealingDeque(std::size_t capacity) :
+	top_{0},
+	bottom_{0},
+	buffer_{new Buffer(capacity)}
+{}
+/**
+ * Destrutor. Libera o buffer atual e os antigos.
+ */
+template<typename T>
+WorkStealingDeque<T>::~WorkStealingDeque() {
+	delete buffer_.load(std::memory_order_relaxed);
+}
+/**
+ * Coloca um elemento na base, dobrando o buffer se estiver cheio. Deve ser
+ * chamado apenas pela thread dona.
+ * \param data referência de um dado.
+ */
+template<typename T>
+void WorkStealingDeque<T>::push(const T& data) {
+	std::int64_t bottom = bottom_.load(std::memory_order_relaxed);
+	std::int64_t top = top_.load(std::memory_order_acquire);
+	Buffer* buffer = buffer_.load(std::memory_order_relaxed);
+	if (bottom - top > static_cast<std::int64_t>(buffer->mask)) {
+		buffer = grow(buffer, top, bottom);
+	}
+	buffer->put(bottom, data);
+	std::atomic_thread_fence(std::memory_order_release);
+	bottom_.store(bottom + 1, std::memory_order_relaxed);
+}
+/**
+ * Tenta retirar o elemento da base (o último colocado). Deve ser chamado
+ * apenas pela thread dona.
+ * \param data recebe o elemento retirado.
+ * \return false se a deque estiver vazia ou se um ladrão levou o último
+ * elemento.
+ */
+template<typename T>
+bool WorkStealingDeque<T>::try_pop(T& data) {
+	std::int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+	Buffer* buffer = buffer_.load(std::memory_order_relaxed);
+	bottom_.store(bottom, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	std::int64_t top = top_.load(std::memory_order_relaxed);
+	if (top > bottom) {
+		bottom_.store(bottom + 1, std::memory_order_relaxed);
+		return false;
+	}
+	data = buffer->get(bottom);
+	if (top < bottom) {
+		return true;
+	}
+	// Último elemento: disputa com os ladrões pelo topo.
+	bool won = top_.compare_exchange_strong(top, top + 1,
+	                                        std::memory_order_seq_cst,
+	                                        std::memory_order_relaxed);
+	bottom_.store(bottom + 1, std::memory_order_relaxed);
+	return won;
+}
+/**
+ * Tenta retirar o elemento do topo (o mais antigo). Pode ser chamado por
+ * qualquer thread.
+ * \param data recebe o elemento retirado.
+ * \return false se a deque estiver vazia ou se outra thread levou o
+ * elemento primeiro.
+ */
+template<typename T>
+bool WorkStealingDeque<T>::try_steal(T& data) {
+	std::int64_t top = top_.load(std::memory_order_acquire);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	std::int64_t bottom = bottom_.load(std::memory_order_acquire);
+	if (top >= bottom) {
+		return false;
+	}
+	Buffer* buffer = buffer_.load(std::memory_order_acquire);
+	T stolen = buffer->get(top);
+	if (!top_.compare_exchange_strong(top, top + 1,
+	                                  std::memory_order_seq_cst,
+	                                  std::memory_order_relaxed)) {
+		return false;
+	}
+	data = stolen;
+	return true;
+}
+/**
+ * Retorna o tamanho da deque. Com outras threads ativas o valor é apenas
+ * aproximado.
+ * \return tamanho da deque.
+ */
+template<typename T>
+std::size_t WorkStealingDeque<T>::size() const {
+	std::int64_t bottom = bottom_.load(std::memory_order_acquire);
+	std::int64_t top = top_.load(std::memory_order_acquire);
+	return bottom > top ? static_cast<std::size_t>(bottom - top) : 0;
+}
+/**
+ * Retorna a capacidade do buffer atual.
+ * \return capacidade do buffer.
+ */
+template<typename T>
+std::size_t WorkStealingDeque<T>::capacity() const {
+	return buffer_.load(std::memory_order_acquire)->mask + 1;
+}
+/**
+ * Verifica se a deque está vazia.
+ * \return booleano
+ */
+template<typename T>
+bool WorkStealingDeque<T>::empty() const {
+	return size() == 0;
+}
+/**
+ * Copia os elementos entre top e bottom para um buffer com o dobro da
+ * capacidade e o publica. O antigo fica encadeado no novo.
+ * \return o novo buffer.
+ */
+template<typename T>
+typename WorkStealingDeque<T>::Buffer* WorkStealingDeque<T>::grow(
+		Buffer* buffer, std::int64_t top, std::int64_t bottom) {
+	Buffer* bigger = new Buffer(2 * (buffer->mask + 1));
+	for (std::int64_t i = top; i < bottom; i++) {
+		bigger->put(i, buffer->get(i));
+	}
+	bigger->previous = buffer;
+	buffer_.store(bigger, std::memory_order_release);
+	return bigger;
+}
+}  // namespace structures
+
+#endif
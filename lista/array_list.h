@@ -3,24 +3,53 @@
 #ifndef STRUCTURES_ARRAY_LIST_H
 #define STRUCTURES_ARRAY_LIST_H
 
+#include <cstddef>  // std::max_align_t
 #include <cstdint>  // std::size_t
+#include <cstdlib>  // std::malloc, std::realloc, std::free
+#include <cstring>  // std::memcpy, std::memmove
+#include <new>  // placement new, std::bad_alloc
 #include <stdexcept>  // C++ Exceptions
+#include <type_traits>  // std::is_trivially_copyable
+#include <utility>  // std::move, std::forward, std::swap
+
+#include "./simd_find.h"
 
 namespace structures {
 /**
  * Implementation of a template list.
+ *
+ * Storage is raw memory: elements are only constructed (placement new) when
+ * inserted and destroyed when removed. A growable list never gets full; it
+ * doubles its capacity when needed. Trivially copyable elements are moved
+ * around with memmove and realloc. find, count and find_all compare a whole
+ * SIMD vector per step for int32_t, int64_t, float and double.
  */
 template<typename T>
 class ArrayList {
  public:
     ArrayList();
     explicit ArrayList(std::size_t max_size);
+    ArrayList(std::size_t max_size, bool growable);
+    ArrayList(const ArrayList& other);
+    ArrayList(ArrayList&& other);
+    ArrayList& operator=(const ArrayList& other);
+    ArrayList& operator=(ArrayList&& other);
     ~ArrayList();
 
     void clear();
+    void swap(ArrayList& other);
     void push_back(const T& data);
+    void push_back(T&& data);
     void push_front(const T& data);
+    void push_front(T&& data);
     void insert(const T& data, std::size_t index);
+    void insert(T&& data, std::size_t index);
+    template<typename... Args>
+    void emplace(std::size_t index, Args&&... args);
+    template<typename... Args>
+    void emplace_back(Args&&... args);
+    template<typename... Args>
+    void emplace_front(Args&&... args);
     void insert_sorted(const T& data);
     T pop(std::size_t index);
     T pop_back();
@@ -30,52 +59,146 @@ class ArrayList {
     bool empty() const;
     bool contains(const T& data) const;
     std::size_t find(const T& data) const;
+    std::size_t count(const T& data) const;
+    ArrayList<std::size_t> find_all(const T& data) const;
     std::size_t size() const;
     std::size_t max_size() const;
     T& at(std::size_t index);
     T& operator[](std::size_t index);
     const T& at(std::size_t index) const;
     const T& operator[](std::size_t index) const;
+    const T* data() const;
+    void reserve(std::size_t capacity);
+    void shrink_to_fit();
+    bool growable() const;
 
  private:
-    T* contents;  // Stores the list data.
+    static const bool trivial = std::is_trivially_copyable<T>::value;
+    static_assert(alignof(T) <= alignof(std::max_align_t),
+                  "ArrayList storage comes from std::malloc");
+
+    void relocate(std::size_t capacity);
+    void open_gap(std::size_t index);
+    void erase_at(std::size_t index);
+
+    T* contents;  // Stores the list data (raw, uninitialized storage).
     std::size_t size_;  // Actual list size.
-    std::size_t max_size_;  // Maximum list size.
+    std::size_t max_size_;  // Maximum list size (current capacity if growable).
+    bool growable_;  // Whether the list grows instead of getting full.
     static const auto DEFAULT_MAX = 10u;  // Default maximum size.
+    static const auto GROWTH_FACTOR = 2u;  // Capacity multiplier on growth.
 };
 /**
  * Constructor. Sets the attributes values.
  */
 template<typename T>
-ArrayList<T>::ArrayList() {
-	max_size_ = DEFAULT_MAX;
-	size_ = 0;
-	contents = new T[max_size_];
-}
+ArrayList<T>::ArrayList() :
+	ArrayList(DEFAULT_MAX, false)
+{}
 /**
  * Constructor. Sets the attributes values with
  * the maximum size as a parameter.
  */
 template<typename T>
-ArrayList<T>::ArrayList(std::size_t max_size) {
-	max_size_ = max_size;
+ArrayList<T>::ArrayList(std::size_t max_size) :
+	ArrayList(max_size, false)
+{}
+/**
+ * Constructor. Sets the attributes values with the initial capacity and
+ * whether the list grows when it runs out of space.
+ */
+template<typename T>
+ArrayList<T>::ArrayList(std::size_t max_size, bool growable) {
+	contents = nullptr;
 	size_ = 0;
-	contents = new T[max_size_];
+	max_size_ = 0;
+	growable_ = growable;
+	relocate(max_size);
+}
+/**
+ * Copy constructor. Allocates once, with the same capacity as other, and
+ * copies only the live elements.
+ */
+template<typename T>
+ArrayList<T>::ArrayList(const ArrayList& other) :
+	ArrayList(other.max_size_, other.growable_)
+{
+	if (trivial) {
+		if (other.size_ != 0) {
+			std::memcpy(static_cast<void*>(contents),
+			            static_cast<const void*>(other.contents),
+			            other.size_ * sizeof(T));
+		}
+		size_ = other.size_;
+		return;
+	}
+	for (std::size_t i = 0; i < other.size_; i++) {
+		new (contents + i) T(other.contents[i]);
+		size_++;
+	}
 }
 /**
- * Destructor. Deletes the contents[] array.
+ * Move constructor. Takes the storage of other, which is left empty and
+ * without capacity.
+ */
+template<typename T>
+ArrayList<T>::ArrayList(ArrayList&& other) {
+	contents = other.contents;
+	size_ = other.size_;
+	max_size_ = other.max_size_;
+	growable_ = other.growable_;
+	other.contents = nullptr;
+	other.size_ = 0;
+	other.max_size_ = 0;
+}
+/**
+ * Copy assignment.
+ */
+template<typename T>
+ArrayList<T>& ArrayList<T>::operator=(const ArrayList& other) {
+	ArrayList copy(other);
+	swap(copy);
+	return *this;
+}
+/**
+ * Move assignment. The previous elements are destroyed.
+ */
+template<typename T>
+ArrayList<T>& ArrayList<T>::operator=(ArrayList&& other) {
+	ArrayList moved(std::move(other));
+	swap(moved);
+	return *this;
+}
+/**
+ * Destructor. Destroys the elements and frees the storage.
  */
 template<typename T>
 ArrayList<T>::~ArrayList() {
-    delete[] contents;
+	clear();
+	std::free(contents);
 }
 /**
- * Clears the list.
+ * Clears the list, destroying its elements.
  */
 template<typename T>
 void ArrayList<T>::clear() {
+	if (!std::is_trivially_destructible<T>::value) {
+		for (std::size_t i = 0; i < size_; i++) {
+			contents[i].~T();
+		}
+	}
 	size_ = 0;
 }
+/**
+ * Exchanges the contents of two lists without touching the elements.
+ */
+template<typename T>
+void ArrayList<T>::swap(ArrayList& other) {
+	std::swap(contents, other.contents);
+	std::swap(size_, other.size_);
+	std::swap(max_size_, other.max_size_);
+	std::swap(growable_, other.growable_);
+}
 /**
  * Adds an element to the end of the list.
  */
@@ -83,6 +206,13 @@ template<typename T>
 void ArrayList<T>::push_back(const T& data) {
     insert(data, size_);
 }
+/**
+ * Adds an element to the end of the list, moving it in.
+ */
+template<typename T>
+void ArrayList<T>::push_back(T&& data) {
+	insert(std::move(data), size_);
+}
 /**
  * Adds an element to the front of the list.
  */
@@ -90,6 +220,13 @@ template<typename T>
 void ArrayList<T>::push_front(const T& data) {
 	insert(data, 0);
 }
+/**
+ * Adds an element to the front of the list, moving it in.
+ */
+template<typename T>
+void ArrayList<T>::push_front(T&& data) {
+	insert(std::move(data), 0);
+}
 /**
  * Inserts an element in the specified location.
  * \param data data reference;
@@ -97,31 +234,146 @@ void ArrayList<T>::push_front(const T& data) {
  */
 template<typename T>
 void ArrayList<T>::insert(const T& data, std::size_t index) {
+	emplace(index, data);
+}
+/**
+ * Inserts an element in the specified location, moving it in.
+ * \param data data to be moved;
+ * \param index index where the element will be put in.
+ */
+template<typename T>
+void ArrayList<T>::insert(T&& data, std::size_t index) {
+	emplace(index, std::move(data));
+}
+/**
+ * Builds an element in the specified location, growing the storage if the
+ * list is growable and out of space.
+ * \param index index where the element will be put in.
+ * \param args arguments for the element constructor.
+ */
+template<typename T>
+template<typename... Args>
+void ArrayList<T>::emplace(std::size_t index, Args&&... args) {
 	if (full()) {
 		throw std::out_of_range("Lista cheia");
 	}
 	if (index > size_) {
 	    throw std::out_of_range("Index inválido");
 	}
-	for(int i = size_; i > index; i--) {
-        contents[i] = contents[i-1];
+	// Built before moving anything, since args may refer to an element.
+	T value(std::forward<Args>(args)...);
+	if (size_ == max_size_) {
+		relocate(max_size_ == 0 ? 1 : max_size_ * GROWTH_FACTOR);
 	}
-	contents[index] = data;
+	open_gap(index);
+	new (contents + index) T(std::move(value));
 	size_++;
 }
 /**
- * Inserts an element respecting numeric progression.
+ * Builds an element at the end of the list.
+ * \param args arguments for the element constructor.
+ */
+template<typename T>
+template<typename... Args>
+void ArrayList<T>::emplace_back(Args&&... args) {
+	emplace(size_, std::forward<Args>(args)...);
+}
+/**
+ * Builds an element at the front of the list.
+ * \param args arguments for the element constructor.
+ */
+template<typename T>
+template<typename... Args>
+void ArrayList<T>::emplace_front(Args&&... args) {
+	emplace(0, std::forward<Args>(args)...);
+}
+/**
+ * Moves the storage to a new block with the given capacity.
+ * \param capacity new capacity; must not be smaller than size().
+ */
+template<typename T>
+void ArrayList<T>::relocate(std::size_t capacity) {
+	if (capacity == 0) {
+		std::free(contents);
+		contents = nullptr;
+	} else if (trivial) {
+		void* moved = std::realloc(static_cast<void*>(contents), capacity * sizeof(T));
+		if (moved == nullptr) {
+			throw std::bad_alloc();
+		}
+		contents = static_cast<T*>(moved);
+	} else {
+		T* moved = static_cast<T*>(std::malloc(capacity * sizeof(T)));
+		if (moved == nullptr) {
+			throw std::bad_alloc();
+		}
+		for (std::size_t i = 0; i < size_; i++) {
+			new (moved + i) T(std::move(contents[i]));
+			contents[i].~T();
+		}
+		std::free(contents);
+		contents = moved;
+	}
+	max_size_ = capacity;
+}
+/**
+ * Shifts the elements from index onwards one slot to the right, leaving
+ * contents[index] unconstructed. There must be a free slot at the end.
+ */
+template<typename T>
+void ArrayList<T>::open_gap(std::size_t index) {
+	if (index == size_) {
+		return;
+	}
+	if (trivial) {
+		std::memmove(static_cast<void*>(contents + index + 1),
+		             static_cast<void*>(contents + index),
+		             (size_ - index) * sizeof(T));
+		return;
+	}
+	new (contents + size_) T(std::move(contents[size_ - 1]));
+	for (std::size_t i = size_ - 1; i > index; i--) {
+		contents[i] = std::move(contents[i - 1]);
+	}
+	contents[index].~T();
+}
+/**
+ * Destroys contents[index] and shifts the following elements one slot to
+ * the left. Does not update size_.
+ */
+template<typename T>
+void ArrayList<T>::erase_at(std::size_t index) {
+	if (trivial) {
+		std::memmove(static_cast<void*>(contents + index),
+		             static_cast<void*>(contents + index + 1),
+		             (size_ - index - 1) * sizeof(T));
+		return;
+	}
+	for (std::size_t i = index; i + 1 < size_; i++) {
+		contents[i] = std::move(contents[i + 1]);
+	}
+	contents[size_ - 1].~T();
+}
+/**
+ * Inserts an element respecting numeric progression. The list must already
+ * be sorted; the position (before any equal elements) is found by binary
+ * search.
  * \param data data.
  */
 template<typename T>
 void ArrayList<T>::insert_sorted(const T& data) {
-    std::size_t  pos_ = 0;
 	if (full()) {
 		throw std::out_of_range("Lista cheia");
 	}
-	for(int i = 0; i < size_; i++) {
-		if (data > contents[i]) {
-		    pos_++;
+	std::size_t pos_ = 0;
+	std::size_t count = size_;
+	while (count > 0) {
+		std::size_t half = count / 2;
+		if (data > contents[pos_ + half]) {
+			pos_ += half + 1;
+			count -= half + 1;
+		} else {
+			count = half;
 		}
 	}
 	insert(data, pos_);
@@ -132,17 +384,14 @@ void ArrayList<T>::insert_sorted(const T& data) {
  */
 template<typename T>
 T ArrayList<T>::pop(std::size_t index) {
-	T value_;
 	if (empty()) {
 		throw std::out_of_range("Lista vazia");
 	}
 	if (index > size_-1) {
 		throw std::out_of_range("Parâmetro inválido");
 	}
-	value_ = contents[index];
-	for(int i = index; i < size_-1; i++) {
-		contents[i] = contents[i+1];
-	}
+	T value_(std::move(contents[index]));
+	erase_at(index);
 	size_--;
 	return value_;
 }
@@ -161,18 +410,15 @@ T ArrayList<T>::pop_front() {
 	return pop(0);
 }
 /**
- * Removes an element by its content.
+ * Removes the first element equal to data, if there is one.
  * \param data data.
  */
 template<typename T>
 void ArrayList<T>::remove(const T& data) {
-	int index_;
-	for(int i = 0; i < size_; i++) {
-		if(contents[i] == data) {
-			index_ = i;
-		}
+	std::size_t index_ = find(data);
+	if (index_ != size_) {
+		pop(index_);
 	}
-	pop(index_);
 }
 /**
  * Checks if the list is full.
@@ -180,7 +426,7 @@ void ArrayList<T>::remove(const T& data) {
  */
 template<typename T>
 bool ArrayList<T>::full() const {
-	return size_ == max_size_;
+	return !growable_ && size_ == max_size_;
 }
 /**
  * Checks if the list is empty.
@@ -199,18 +445,36 @@ bool ArrayList<T>::contains(const T& data) const {
 	return find(data) != size();
 }
 /**
- * Checks if the list has a certain element, and if so, returns its index.
- * \return specified element index.
+ * Checks if the list has a certain element, and if so, returns the index
+ * of its first occurrence.
+ * \return specified element index, or size() if it is not there.
  */
 template<typename T>
 std::size_t ArrayList<T>::find(const T& data) const {
-	std::size_t index_ = size();
-	for(int i = 0; i < size_; i++) {
-		if(contents[i] == data) {
-			index_ = i;
-		}
+	return simd::find(contents, size_, data);
+}
+/**
+ * Counts the elements equal to data.
+ * \return number of occurrences.
+ */
+template<typename T>
+std::size_t ArrayList<T>::count(const T& data) const {
+	return simd::count(contents, size_, data);
+}
+/**
+ * Returns the indexes of every element equal to data, in ascending order.
+ * \return growable list of indexes.
+ */
+template<typename T>
+ArrayList<std::size_t> ArrayList<T>::find_all(const T& data) const {
+	ArrayList<std::size_t> indexes(0, true);
+	std::size_t index_ = simd::find(contents, size_, data);
+	while (index_ != size_) {
+		indexes.push_back(index_);
+		index_ += 1;
+		index_ += simd::find(contents + index_, size_ - index_, data);
 	}
-	return index_;
+	return indexes;
 }
 /**
  * Returns the list actual size.
@@ -220,7 +484,8 @@ std::size_t ArrayList<T>::size() const {
 	return size_;
 }
 /**
- * Returns the list maximum size.
+ * Returns the list maximum size. For a growable list this is the current
+ * capacity.
  */
 template<typename T>
 std::size_t ArrayList<T>::max_size() const {
@@ -231,7 +496,7 @@ std::size_t ArrayList<T>::max_size() const {
  */
 template<typename T>
 T& ArrayList<T>::at(std::size_t index) {
-    if (index > size_-1) {
+    if (index >= size_) {
         throw std::out_of_range("Index inválido");
     }
 	return contents[index];
@@ -248,7 +513,10 @@ T& ArrayList<T>::operator[](std::size_t index) {
  */
 template<typename T>
 const T& ArrayList<T>::at(std::size_t index) const {
-	return at(index);
+    if (index >= size_) {
+        throw std::out_of_range("Index inválido");
+    }
+	return contents[index];
 }
 /**
  * Returns a reference to the element at the specified index.
@@ -257,6 +525,43 @@ template<typename T>
 const T& ArrayList<T>::operator[](std::size_t index) const {
     return at(index);
 }
+/**
+ * Returns a pointer to the first of the size() contiguous elements, for
+ * reads without bounds checks.
+ */
+template<typename T>
+const T* ArrayList<T>::data() const {
+	return contents;
+}
+/**
+ * Makes room for at least capacity elements without constructing them.
+ * Does nothing on a fixed-size list, whose capacity is its maximum size.
+ * \param capacity requested capacity.
+ */
+template<typename T>
+void ArrayList<T>::reserve(std::size_t capacity) {
+	if (growable_ && capacity > max_size_) {
+		relocate(capacity);
+	}
+}
+/**
+ * Reduces the capacity to the current size. Does nothing on a fixed-size
+ * list, whose capacity is its maximum size.
+ */
+template<typename T>
+void ArrayList<T>::shrink_to_fit() {
+	if (growable_ && size_ < max_size_) {
+		relocate(size_);
+	}
+}
+/**
+ * Checks if the list grows instead of getting full.
+ * \return boolean
+ */
+template<typename T>
+bool ArrayList<T>::growable() const {
+	return growable_;
+}
 }  // namespace structures
 
 #endif
@@ -0,0 +1,308 @@
+// Copyright 2017 Eduardo Kohler
+
+#ifndef STRUCTURES_SIMD_FIND_H
+#define STRUCTURES_SIMD_FIND_H
+
+#include <cstdint>  // std::size_t, std::int32_t, std::int64_t
+
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#define STRUCTURES_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+namespace structures {
+namespace simd {
+/**
+ * Linear search kernels for contiguous arrays.
+ *
+ * The generic versions compare one element at a time. For int32_t, int64_t,
+ * float and double on x86-64 a whole vector is compared per step: SSE2 is
+ * always available there, and AVX2 is used when the CPU reports it (checked
+ * once, at the first call). Equality follows operator== of the element type,
+ * so NaN never matches and 0.0 matches -0.0.
+ */
+template <typename T>
+std::size_t find(const T* data, std::size_t size, const T& value) {
+  for (std::size_t i = 0; i < size; i++) {
+    if (data[i] == value) {
+      return i;
+    }
+  }
+  return size;
+}
+
+template <typename T>
+std::size_t count(const T* data, std::size_t size, const T& value) {
+  std::size_t total = 0;
+  for (std::size_t i = 0; i < size; i++) {
+    if (data[i] == value) {
+      total++;
+    }
+  }
+  return total;
+}
+
+#ifdef STRUCTURES_SIMD_X86
+namespace detail {
+#define STRUCTURES_AVX2 __attribute__((target("avx2")))
+
+/**
+ * Per-type vector operations. match() compares the lanes starting at data
+ * with key and returns one bit per equal lane.
+ */
+struct Sse2Int32 {
+  using type = std::int32_t;
+  using vector = __m128i;
+  static const std::size_t LANES = 4;
+  static vector splat(type value) { return _mm_set1_epi32(value); }
+  static unsigned match(const type* data, vector key) {
+    __m128i lanes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+    return _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(lanes, key)));
+  }
+};
+
+struct Sse2Int64 {
+  using type = std::int64_t;
+  using vector = __m128i;
+  static const std::size_t LANES = 2;
+  static vector splat(type value) { return _mm_set1_epi64x(value); }
+  static unsigned match(const type* data, vector key) {
+    // No 64-bit compare in SSE2: both 32-bit halves must be equal.
+    __m128i lanes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+    __m128i halves = _mm_cmpeq_epi32(lanes, key);
+    __m128i swapped = _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1));
+    return _mm_movemask_pd(_mm_castsi128_pd(_mm_and_si128(halves, swapped)));
+  }
+};
+
+struct Sse2Float {
+  using type = float;
+  using vector = __m128;
+  static const std::size_t LANES = 4;
+  static vector splat(type value) { return _mm_set1_ps(value); }
+  static unsigned match(const type* data, vector key) {
+    return _mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(data), key));
+  }
+};
+
+struct Sse2Double {
+  using type = double;
+  using vector = __m128d;
+  static const std::size_t LANES = 2;
+  static vector splat(type value) { return _mm_set1_pd(value); }
+  static unsigned match(const type* data, vector key) {
+    return _mm_movemask_pd(_mm_cmpeq_pd(_mm_loadu_pd(data), key));
+  }
+};
+
+struct Avx2Int32 {
+  using type = std::int32_t;
+  using vector = __m256i;
+  static const std::size_t LANES = 8;
+  STRUCTURES_AVX2 static vector splat(type value) {
+    return _mm256_set1_epi32(value);
+  }
+  STRUCTURES_AVX2 static unsigned match(const type* data, vector key) {
+    __m256i lanes =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+    return _mm256_movemask_ps(
+        _mm256_castsi256_ps(_mm256_cmpeq_epi32(lanes, key)));
+  }
+};
+
+struct Avx2Int64 {
+  using type = std::int64_t;
+  using vector = __m256i;
+  static const std::size_t LANES = 4;
+  STRUCTURES_AVX2 static vector splat(type value) {
+    return _mm256_set1_epi64x(value);
+  }
+  STRUCTURES_AVX2 static unsigned match(const type* data, vector key) {
+    __m256i lanes =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+    return _mm256_movemask_pd(
+        _mm256_castsi256_pd(_mm256_cmpeq_epi64(lanes, key)));
+  }
+};
+
+struct Avx2Float {
+  using type = float;
+  using vector = __m256;
+  static const std::size_t LANES = 8;
+  STRUCTURES_AVX2 static vector splat(type value) {
+    return _mm256_set1_ps(value);
+  }
+  STRUCTURES_AVX2 static unsigned match(const type* data, vector key) {
+    return _mm256_movemask_ps(
+        _mm256_cmp_ps(_mm256_loadu_ps(data), key, _CMP_EQ_OQ));
+  }
+};
+
+struct Avx2Double {
+  using type = double;
+  using vector = __m256d;
+  static const std::size_t LANES = 4;
+  STRUCTURES_AVX2 static vector splat(type value) {
+    return _mm256_set1_pd(value);
+  }
+  STRUCTURES_AVX2 static unsigned match(const type* data, vector key) {
+    return _mm256_movemask_pd(
+        _mm256_cmp_pd(_mm256_loadu_pd(data), key, _CMP_EQ_OQ));
+  }
+};
+
+/**
+ * Scans a vector at a time and stops at the first lane that matches; the
+ * remaining size % LANES elements are compared one by one.
+ */
+template <typename Ops>
+std::size_t find_sse2(const typename Ops::type* data, std::size_t size,
+                      typename Ops::type value) {
+  typename Ops::vector key = Ops::splat(value);
+  std::size_t i = 0;
+  for (; i + Ops::LANES <= size; i += Ops::LANES) {
+    unsigned mask = Ops::match(data + i, key);
+    if (mask != 0) {
+      return i + __builtin_ctz(mask);
+    }
+  }
+  for (; i < size; i++) {
+    if (data[i] == value) {
+      return i;
+    }
+  }
+  return size;
+}
+
+template <typename Ops>
+std::size_t count_sse2(const typename Ops::type* data, std::size_t size,
+                       typename Ops::type value) {
+  typename Ops::vector key = Ops::splat(value);
+  std::size_t total = 0;
+  std::size_t i = 0;
+  for (; i + Ops::LANES <= size; i += Ops::LANES) {
+    total += __builtin_popcount(Ops::match(data + i, key));
+  }
+  for (; i < size; i++) {
+    if (data[i] == value) {
+      total++;
+    }
+  }
+  return total;
+}
+
+/**
+ * Same loops as find_sse2/count_sse2, compiled for AVX2.
+ */
+template <typename Ops>
+STRUCTURES_AVX2 std::size_t find_avx2(const typename Ops::type* data,
+                                      std::size_t size,
+                                      typename Ops::type value) {
+  typename Ops::vector key = Ops::splat(value);
+  std::size_t i = 0;
+  for (; i + Ops::LANES <= size; i += Ops::LANES) {
+    unsigned mask = Ops::match(data + i, key);
+    if (mask != 0) {
+      return i + __builtin_ctz(mask);
+    }
+  }
+  for (; i < size; i++) {
+    if (data[i] == value) {
+      return i;
+    }
+  }
+  return size;
+}
+
+template <typename Ops>
+STRUCTURES_AVX2 std::size_t count_avx2(const typename Ops::type* data,
+                                       std::size_t size,
+                                       typename Ops::type value) {
+  typename Ops::vector key = Ops::splat(value);
+  std::size_t total = 0;
+  std::size_t i = 0;
+  for (; i + Ops::LANES <= size; i += Ops::LANES) {
+    total += __builtin_popcount(Ops::match(data + i, key));
+  }
+  for (; i < size; i++) {
+    if (data[i] == value) {
+      total++;
+    }
+  }
+  return total;
+}
+
+#undef STRUCTURES_AVX2
+
+/**
+ * Whether the running CPU supports AVX2. Queried once.
+ */
+inline bool has_avx2() {
+  static const bool avx2 = [] {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+  }();
+  return avx2;
+}
+}  // namespace detail
+
+inline std::size_t find(const std::int32_t* data, std::size_t size,
+                        const std::int32_t& value) {
+  return detail::has_avx2()
+             ? detail::find_avx2<detail::Avx2Int32>(data, size, value)
+             : detail::find_sse2<detail::Sse2Int32>(data, size, value);
+}
+
+inline std::size_t find(const std::int64_t* data, std::size_t size,
+                        const std::int64_t& value) {
+  return detail::has_avx2()
+             ? detail::find_avx2<detail::Avx2Int64>(data, size, value)
+             : detail::find_sse2<detail::Sse2Int64>(data, size, value);
+}
+
+inline std::size_t find(const float* data, std::size_t size,
+                        const float& value) {
+  return detail::has_avx2()
+             ? detail::find_avx2<detail::Avx2Float>(data, size, value)
+             : detail::find_sse2<detail::Sse2Float>(data, size, value);
+}
+
+inline std::size_t find(const double* data, std::size_t size,
+                        const double& value) {
+  return detail::has_avx2()
+             ? detail::find_avx2<detail::Avx2Double>(data, size, value)
+             : detail::find_sse2<detail::Sse2Double>(data, size, value);
+}
+
+inline std::size_t count(const std::int32_t* data, std::size_t size,
+                         const std::int32_t& value) {
+  return detail::has_avx2()
+             ? detail::count_avx2<detail::Avx2Int32>(data, size, value)
+             : detail::count_sse2<detail::Sse2Int32>(data, size, value);
+}
+
+inline std::size_t count(const std::int64_t* data, std::size_t size,
+                         const std::int64_t& value) {
+  return detail::has_avx2()
+             ? detail::count_avx2<detail::Avx2Int64>(data, size, value)
+             : detail::count_sse2<detail::Sse2Int64>(data, size, value);
+}
+
+inline std::size_t count(const float* data, std::size_t size,
+                         const float& value) {
+  return detail::has_avx2()
+             ? detail::count_avx2<detail::Avx2Float>(data, size, value)
+             : detail::count_sse2<detail::Sse2Float>(data, size, value);
+}
+
+inline std::size_t count(const double* data, std::size_t size,
+                         const double& value) {
+  return detail::has_avx2()
+             ? detail::count_avx2<detail::Avx2Double>(data, size, value)
+             : detail::count_sse2<detail::Sse2Double>(data, size, value);
+}
+#endif  // STRUCTURES_SIMD_X86
+}  // namespace simd
+}  // namespace structures
+
+#endif
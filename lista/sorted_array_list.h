@@ -0,0 +1,286 @@
+// Copyright 2017 Eduardo Kohler
+
+#ifndef STRUCTURES_SORTED_ARRAY_LIST_H
+#define STRUCTURES_SORTED_ARRAY_LIST_H
+
+#include <cstdint>  // std::size_t
+#include <stdexcept>  // C++ Exceptions
+#include <utility>  // std::pair, std::move
+
+#include "./array_list.h"
+
+namespace structures {
+/**
+ * Implementation of a template list kept in ascending order.
+ *
+ * Elements live in an ArrayList; positions are found by binary search
+ * (operator<), so find, contains and the bound queries are O(log n).
+ * Inserting still shifts the tail of the array, which is a single memmove
+ * for trivially copyable types. Elements are only reachable through const
+ * references, since changing one in place could break the ordering.
+ */
+template<typename T>
+class SortedArrayList {
+ public:
+    SortedArrayList();
+    explicit SortedArrayList(std::size_t max_size);
+    SortedArrayList(std::size_t max_size, bool growable);
+
+    void clear();
+    void swap(SortedArrayList& other);
+    std::size_t insert_sorted(const T& data);
+    std::size_t insert_sorted(T&& data);
+    T pop(std::size_t index);
+    T pop_back();
+    T pop_front();
+    void remove(const T& data);
+    bool full() const;
+    bool empty() const;
+    bool contains(const T& data) const;
+    std::size_t find(const T& data) const;
+    std::size_t lower_bound(const T& data) const;
+    std::size_t upper_bound(const T& data) const;
+    std::pair<std::size_t, std::size_t> equal_range(const T& data) const;
+    std::size_t size() const;
+    std::size_t max_size() const;
+    const T& at(std::size_t index) const;
+    const T& operator[](std::size_t index) const;
+    void reserve(std::size_t capacity);
+    void shrink_to_fit();
+
+ private:
+    ArrayList<T> list_;  // Elements, in ascending order.
+};
+/**
+ * Constructor. Sets the attributes values.
+ */
+template<typename T>
+SortedArrayList<T>::SortedArrayList() :
+	list_()
+{}
+/**
+ * Constructor. Sets the attributes values with
+ * the maximum size as a parameter.
+ */
+template<typename T>
+SortedArrayList<T>::SortedArrayList(std::size_t max_size) :
+	list_(max_size)
+{}
+/**
+ * Constructor. Sets the attributes values with the initial capacity and
+ * whether the list grows when it runs out of space.
+ */
+template<typename T>
+SortedArrayList<T>::SortedArrayList(std::size_t max_size, bool growable) :
+	list_(max_size, growable)
+{}
+/**
+ * Clears the list, destroying its elements.
+ */
+template<typename T>
+void SortedArrayList<T>::clear() {
+	list_.clear();
+}
+/**
+ * Exchanges the contents of two lists without touching the elements.
+ */
+template<typename T>
+void SortedArrayList<T>::swap(SortedArrayList& other) {
+	list_.swap(other.list_);
+}
+/**
+ * Inserts an element after any equal ones, keeping the list sorted.
+ * \param data data reference.
+ * \return index where the element was put in.
+ */
+template<typename T>
+std::size_t SortedArrayList<T>::insert_sorted(const T& data) {
+	if (full()) {
+		throw std::out_of_range("Lista cheia");
+	}
+	std::size_t index = upper_bound(data);
+	list_.insert(data, index);
+	return index;
+}
+/**
+ * Inserts an element after any equal ones, moving it in.
+ * \param data data to be moved.
+ * \return index where the element was put in.
+ */
+template<typename T>
+std::size_t SortedArrayList<T>::insert_sorted(T&& data) {
+	if (full()) {
+		throw std::out_of_range("Lista cheia");
+	}
+	std::size_t index = upper_bound(data);
+	list_.insert(std::move(data), index);
+	return index;
+}
+/**
+ * Takes an element out by its index.
+ * \param index element index.
+ */
+template<typename T>
+T SortedArrayList<T>::pop(std::size_t index) {
+	return list_.pop(index);
+}
+/**
+ * Removes the last (greatest) element.
+ */
+template<typename T>
+T SortedArrayList<T>::pop_back() {
+	return list_.pop_back();
+}
+/**
+ * Removes the first (smallest) element.
+ */
+template<typename T>
+T SortedArrayList<T>::pop_front() {
+	return list_.pop_front();
+}
+/**
+ * Removes the first element equal to data, if there is one.
+ * \param data data.
+ */
+template<typename T>
+void SortedArrayList<T>::remove(const T& data) {
+	std::size_t index = find(data);
+	if (index != size()) {
+		list_.pop(index);
+	}
+}
+/**
+ * Checks if the list is full.
+ * \return boolean
+ */
+template<typename T>
+bool SortedArrayList<T>::full() const {
+	return list_.full();
+}
+/**
+ * Checks if the list is empty.
+ * \return boolean
+ */
+template<typename T>
+bool SortedArrayList<T>::empty() const {
+	return list_.empty();
+}
+/**
+ * Checks if the list contains a certain element by its content.
+ * \return boolean
+ */
+template<typename T>
+bool SortedArrayList<T>::contains(const T& data) const {
+	return find(data) != size();
+}
+/**
+ * Returns the index of the first element equal to data, or size() if there
+ * is none.
+ * \return specified element index.
+ */
+template<typename T>
+std::size_t SortedArrayList<T>::find(const T& data) const {
+	std::size_t index = lower_bound(data);
+	if (index != size() && !(data < list_[index])) {
+		return index;
+	}
+	return size();
+}
+/**
+ * Returns the index of the first element not less than data.
+ * \param data data.
+ */
+template<typename T>
+std::size_t SortedArrayList<T>::lower_bound(const T& data) const {
+	const T* elements = list_.data();  // probes are in range: no checks
+	std::size_t first = 0;
+	std::size_t count = size();
+	while (count > 0) {
+		std::size_t half = count / 2;
+		if (elements[first + half] < data) {
+			first += half + 1;
+			count -= half + 1;
+		} else {
+			count = half;
+		}
+	}
+	return first;
+}
+/**
+ * Returns the index of the first element greater than data.
+ * \param data data.
+ */
+template<typename T>
+std::size_t SortedArrayList<T>::upper_bound(const T& data) const {
+	const T* elements = list_.data();  // probes are in range: no checks
+	std::size_t first = 0;
+	std::size_t count = size();
+	while (count > 0) {
+		std::size_t half = count / 2;
+		if (!(data < elements[first + half])) {
+			first += half + 1;
+			count -= half + 1;
+		} else {
+			count = half;
+		}
+	}
+	return first;
+}
+/**
+ * Returns the range [first, second) of the elements equal to data.
+ * \param data data.
+ */
+template<typename T>
+std::pair<std::size_t, std::size_t>
+SortedArrayList<T>::equal_range(const T& data) const {
+	return std::make_pair(lower_bound(data), upper_bound(data));
+}
+/**
+ * Returns the list actual size.
+ */
+template<typename T>
+std::size_t SortedArrayList<T>::size() const {
+	return list_.size();
+}
+/**
+ * Returns the list maximum size. For a growable list this is the current
+ * capacity.
+ */
+template<typename T>
+std::size_t SortedArrayList<T>::max_size() const {
+	return list_.max_size();
+}
+/**
+ * Returns a reference to the element at the specified index.
+ */
+template<typename T>
+const T& SortedArrayList<T>::at(std::size_t index) const {
+	return list_.at(index);
+}
+/**
+ * Returns a reference to the element at the specified index.
+ */
+template<typename T>
+const T& SortedArrayList<T>::operator[](std::size_t index) const {
+	return list_.at(index);
+}
+/**
+ * Makes room for at least capacity elements without constructing them.
+ * Does nothing on a fixed-size list.
+ * \param capacity requested capacity.
+ */
+template<typename T>
+void SortedArrayList<T>::reserve(std::size_t capacity) {
+	list_.reserve(capacity);
+}
+/**
+ * Reduces the capacity to the current size. Does nothing on a fixed-size
+ * list.
+ */
+template<typename T>
+void SortedArrayList<T>::shrink_to_fit() {
+	list_.shrink_to_fit();
+}
+}  // namespace structures
+
+#endif
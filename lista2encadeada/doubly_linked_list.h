@@ -1,25 +1,60 @@
 // Copyright 2017 Eduardo Kohler
 
-#ifndef STRUCTURES_ARRAY_LIST_H
-#define STRUCTURES_ARRAY_LIST_H
+#ifndef STRUCTURES_DOUBLY_LINKED_LIST_H
+#define STRUCTURES_DOUBLY_LINKED_LIST_H
 
-#include <cstdint>    // std::size_t
-#include <stdexcept>  // C++ Exceptions
+#include <cstddef>      // std::ptrdiff_t
+#include <cstdint>      // std::size_t
+#include <iterator>     // std::bidirectional_iterator_tag
+#include <memory>       // std::allocator, std::allocator_traits
+#include <stdexcept>    // C++ Exceptions
+#include <type_traits>  // std::conditional, std::is_trivially_destructible
+#include <utility>      // std::forward, std::move, std::swap
+
+#include "../memoria/node_pool.h"
 
 namespace structures {
 /**
 * Implementation of a template doubly linked list.
+*
+* Nodes are obtained from Alloc (e.g. PoolAllocator<T>). Besides head and
+* tail the list remembers the last node reached by index (the finger), and
+* indexed operations walk from whichever of the three is closest, so
+* sequential loops over at(i) cost O(1) per step. Since even const access
+* moves the finger, concurrent readers need external synchronization.
+*
+* Iterators are bidirectional. insert_after, erase and splice at an
+* iterator are O(1), except that a range splice from another list counts
+* its elements. They drop the finger, and only invalidate iterators to
+* erased elements.
 */
-template <typename T>
+template <typename T, typename Alloc = std::allocator<T>>
 class DoublyLinkedList {
  public:
+  template <bool Const>
+  class Iterator;
+  using iterator = Iterator<false>;
+  using const_iterator = Iterator<true>;
+
   DoublyLinkedList();
+  DoublyLinkedList(const DoublyLinkedList& other);
+  DoublyLinkedList(DoublyLinkedList&& other);
+  DoublyLinkedList& operator=(const DoublyLinkedList& other);
+  DoublyLinkedList& operator=(DoublyLinkedList&& other);
   ~DoublyLinkedList();
   void clear();
+  void swap(DoublyLinkedList& other);
 
   void push_back(const T& data);
+  void push_back(T&& data);
   void push_front(const T& data);
+  void push_front(T&& data);
+  template <typename... Args>
+  void emplace_back(Args&&... args);
+  template <typename... Args>
+  void emplace_front(Args&&... args);
   void insert(const T& data, std::size_t index);
+  void insert(T&& data, std::size_t index);
   void insert_sorted(const T& data);
 
   T pop(std::size_t index);
@@ -32,14 +67,44 @@ class DoublyLinkedList {
 
   T& at(std::size_t index);
   const T& at(std::size_t index) const;
+  T& front();
+  const T& front() const;
+  T& back();
+  const T& back() const;
 
   std::size_t find(const T& data) const;
   std::size_t size() const;
 
+  iterator begin();
+  const_iterator begin() const;
+  const_iterator cbegin() const;
+  iterator end();
+  const_iterator end() const;
+  const_iterator cend() const;
+  iterator insert_after(const_iterator pos, const T& data);
+  iterator insert_after(const_iterator pos, T&& data);
+  iterator erase(const_iterator pos);
+  void splice(const_iterator pos, DoublyLinkedList& other);
+  void splice(const_iterator pos, DoublyLinkedList& other, const_iterator it);
+  void splice(const_iterator pos, DoublyLinkedList& other,
+              const_iterator first, const_iterator last);
+  void sort();
+  template <typename Compare>
+  void sort(Compare comp);
+  void merge(DoublyLinkedList& other);
+  template <typename Compare>
+  void merge(DoublyLinkedList& other, Compare comp);
+
  private:
+  struct InPlace {};  // tag: build the data from constructor arguments
+
   class Node {
    public:
     explicit Node(const T& data) : data_{data} {}
+    explicit Node(T&& data) : data_{std::move(data)} {}
+    template <typename... Args>
+    explicit Node(InPlace, Args&&... args)
+        : data_(std::forward<Args>(args)...) {}
     Node(const T& data, Node* next) : data_{data}, next_{next} {}
     Node(const T& data, Node* next, Node* prev)
         : data_{data}, next_{next}, prev_{prev} {}
@@ -61,158 +126,393 @@ class DoublyLinkedList {
     Node* prev_{nullptr};
   };
 
-  Node* end() {
-    auto it = head;
-    for (auto i = 1u; i < size(); ++i) {
-      it = it->next();
+  using NodeAlloc =
+      typename std::allocator_traits<Alloc>::template rebind_alloc<Node>;
+  using NodeTraits = std::allocator_traits<NodeAlloc>;
+
+  template <typename... Args>
+  Node* new_node(Args&&... args) {
+    Node* node = NodeTraits::allocate(node_alloc_, 1);
+    try {
+      NodeTraits::construct(node_alloc_, node, std::forward<Args>(args)...);
+    } catch (...) {
+      NodeTraits::deallocate(node_alloc_, node, 1);
+      throw;
     }
-    return it;
+    return node;
+  }
+
+  void delete_node(Node* node) {
+    NodeTraits::destroy(node_alloc_, node);
+    NodeTraits::deallocate(node_alloc_, node, 1);
   }
+
+  void link(Node* node, std::size_t index);
+  T unlink(Node* node, std::size_t index);
+  Node* node_at(std::size_t index) const;
+  void attach(Node* next, Node* first, Node* last, std::size_t count);
+  void detach(Node* first, Node* last, std::size_t count);
+  void check_splice(const DoublyLinkedList& other) const;
+
   Node* head{nullptr};
+  Node* tail{nullptr};
   std::size_t size_{0u};
+  NodeAlloc node_alloc_;
+  mutable Node* finger_{nullptr};         // last node reached by index
+  mutable std::size_t finger_index_{0u};  // index of finger_
+};
+/**
+ * Bidirectional iterator over a DoublyLinkedList. The past-the-end
+ * iterator has no node, so the iterator also points to its list in order
+ * to step back from end() to the tail.
+ */
+template <typename T, typename Alloc>
+template <bool Const>
+class DoublyLinkedList<T, Alloc>::Iterator {
+ public:
+  using iterator_category = std::bidirectional_iterator_tag;
+  using value_type = T;
+  using difference_type = std::ptrdiff_t;
+  using pointer = typename std::conditional<Const, const T*, T*>::type;
+  using reference = typename std::conditional<Const, const T&, T&>::type;
+
+  Iterator() = default;
+
+  template <bool C, typename = typename std::enable_if<Const && !C>::type>
+  Iterator(const Iterator<C>& other)  // NOLINT(runtime/explicit)
+      : node_{other.node_}, list_{other.list_} {}
+
+  reference operator*() const { return node_->data(); }
+
+  pointer operator->() const { return &node_->data(); }
+
+  Iterator& operator++() {
+    node_ = node_->next();
+    return *this;
+  }
+
+  Iterator operator++(int) {
+    Iterator old = *this;
+    ++*this;
+    return old;
+  }
+
+  Iterator& operator--() {
+    node_ = node_ == nullptr ? list_->tail : node_->prev();
+    return *this;
+  }
+
+  Iterator operator--(int) {
+    Iterator old = *this;
+    --*this;
+    return old;
+  }
+
+  bool operator==(const Iterator& other) const { return node_ == other.node_; }
+
+  bool operator!=(const Iterator& other) const { return node_ != other.node_; }
+
+ private:
+  friend class DoublyLinkedList;
+  friend class Iterator<!Const>;
+
+  Iterator(Node* node, const DoublyLinkedList* list)
+      : node_{node}, list_{list} {}
+
+  Node* node_{nullptr};
+  const DoublyLinkedList* list_{nullptr};
 };
 /**
  * Constructor. Sets the attributes values.
  */
-template <typename T>
-DoublyLinkedList<T>::DoublyLinkedList() {
+template <typename T, typename Alloc>
+DoublyLinkedList<T, Alloc>::DoublyLinkedList() {
   head = nullptr;
   size_ = 0;
 }
+/**
+ * Copy constructor. Copies every element of other, in order.
+ */
+template <typename T, typename Alloc>
+DoublyLinkedList<T, Alloc>::DoublyLinkedList(const DoublyLinkedList& other)
+    : node_alloc_{NodeTraits::select_on_container_copy_construction(
+          other.node_alloc_)} {
+  Node* last = nullptr;
+  try {
+    for (const Node* it = other.head; it != nullptr; it = it->next()) {
+      Node* input = new_node(it->data());
+      if (last == nullptr) {
+        head = input;
+      } else {
+        last->next(input);
+        input->prev(last);
+      }
+      last = input;
+      tail = input;
+      size_++;
+    }
+  } catch (...) {
+    clear();
+    throw;
+  }
+}
+/**
+ * Move constructor. Takes the nodes of other, leaving it empty.
+ */
+template <typename T, typename Alloc>
+DoublyLinkedList<T, Alloc>::DoublyLinkedList(DoublyLinkedList&& other)
+    : head{other.head},
+      tail{other.tail},
+      size_{other.size_},
+      node_alloc_{other.node_alloc_},
+      finger_{other.finger_},
+      finger_index_{other.finger_index_} {
+  other.head = nullptr;
+  other.tail = nullptr;
+  other.size_ = 0;
+  other.finger_ = nullptr;
+}
+/**
+ * Copy assignment.
+ */
+template <typename T, typename Alloc>
+DoublyLinkedList<T, Alloc>& DoublyLinkedList<T, Alloc>::operator=(
+    const DoublyLinkedList& other) {
+  DoublyLinkedList copy(other);
+  swap(copy);
+  return *this;
+}
+/**
+ * Move assignment. The previous elements are destroyed.
+ */
+template <typename T, typename Alloc>
+DoublyLinkedList<T, Alloc>& DoublyLinkedList<T, Alloc>::operator=(
+    DoublyLinkedList&& other) {
+  DoublyLinkedList moved(std::move(other));
+  swap(moved);
+  return *this;
+}
 /**
  * Destructor. Deletes the contents[] array.
  */
-template <typename T>
-DoublyLinkedList<T>::~DoublyLinkedList() {
+template <typename T, typename Alloc>
+DoublyLinkedList<T, Alloc>::~DoublyLinkedList() {
   clear();
 }
 /**
- * Clears the list.
+ * Clears the list. Nodes are destroyed in place, without copying their
+ * data out; with a PoolAllocator the whole pool is released at once.
  */
-template <typename T>
-void DoublyLinkedList<T>::clear() {
-  while (!empty()) {
-    pop_front();
+template <typename T, typename Alloc>
+void DoublyLinkedList<T, Alloc>::clear() {
+  bool bulk = BulkRelease<NodeAlloc>::available(node_alloc_);
+  if (!bulk || !std::is_trivially_destructible<T>::value) {
+    Node* current = head;
+    for (std::size_t i = 0; i < size_; i++) {
+      Node* next = current->next();
+      if (bulk) {
+        NodeTraits::destroy(node_alloc_, current);
+      } else {
+        delete_node(current);
+      }
+      current = next;
+    }
+  }
+  if (bulk) {
+    BulkRelease<NodeAlloc>::release(node_alloc_);
   }
+  head = nullptr;
+  tail = nullptr;
+  size_ = 0;
+  finger_ = nullptr;
+}
+/**
+ * Exchanges the contents of two lists in O(1).
+ */
+template <typename T, typename Alloc>
+void DoublyLinkedList<T, Alloc>::swap(DoublyLinkedList& other) {
+  std::swap(head, other.head);
+  std::swap(tail, other.tail);
+  std::swap(size_, other.size_);
+  std::swap(node_alloc_, other.node_alloc_);
+  std::swap(finger_, other.finger_);
+  std::swap(finger_index_, other.finger_index_);
 }
 /**
  * Checks if the list is empty.
  * \return boolean
  */
-template <typename T>
-bool DoublyLinkedList<T>::empty() const {
+template <typename T, typename Alloc>
+bool DoublyLinkedList<T, Alloc>::empty() const {
   return size_ == 0;
 }
 /**
  * Adds an element to the front of the list.
  */
-template <typename T>
-void DoublyLinkedList<T>::push_front(const T& data) {
-  Node* first = new Node(data);
-  Node* next;
-  if (first == nullptr) {
-    throw std::out_of_range("Lista cheia.");
-  } else if (!empty()) {
-    next = head;
-    next->prev(first);
-  }
-  first->prev(nullptr);
-  first->next(head);
-  head = first;
-  size_++;
+template <typename T, typename Alloc>
+void DoublyLinkedList<T, Alloc>::push_front(const T& data) {
+  link(new_node(data), 0);
+}
+/**
+ * Adds an element to the front of the list, moving it in.
+ */
+template <typename T, typename Alloc>
+void DoublyLinkedList<T, Alloc>::push_front(T&& data) {
+  link(new_node(std::move(data)), 0);
+}
+/**
+ * Builds an element at the front of the list from constructor arguments.
+ */
+template <typename T, typename Alloc>
+template <typename... Args>
+void DoublyLinkedList<T, Alloc>::emplace_front(Args&&... args) {
+  link(new_node(InPlace{}, std::forward<Args>(args)...), 0);
 }
 /**
  * Removes the first element.
  * \return The first element of type T.
  */
-template <typename T>
-T DoublyLinkedList<T>::pop_front() {
+template <typename T, typename Alloc>
+T DoublyLinkedList<T, Alloc>::pop_front() {
   if (empty()) {
     throw std::out_of_range("Lista vazia");
   } else {
-    Node* first = head;
-    T out_ = first->data();
-    head = first->next();
-    if (head != nullptr) {
-      head->prev(nullptr);
+    return unlink(head, 0);
+  }
+}
+/**
+ * Links an already built node so that it ends up at the given index.
+ * \param node node to be linked;
+ * \param index valid position (at most size()).
+ */
+template <typename T, typename Alloc>
+void DoublyLinkedList<T, Alloc>::link(Node* node, std::size_t index) {
+  Node* next = index == size_ ? nullptr : node_at(index);
+  Node* prev = next == nullptr ? tail : next->prev();
+  node->prev(prev);
+  node->next(next);
+  if (prev != nullptr) {
+    prev->next(node);
+  } else {
+    head = node;
+  }
+  if (next != nullptr) {
+    next->prev(node);
+  } else {
+    tail = node;
+  }
+  size_++;
+  finger_ = node;
+  finger_index_ = index;
+}
+/**
+ * Unlinks a node from the list and frees it. The finger moves to the node
+ * that takes its place (or to its predecessor at the end of the list).
+ * \param node node that belongs to this list;
+ * \param index its position.
+ * \return the data it held.
+ */
+template <typename T, typename Alloc>
+T DoublyLinkedList<T, Alloc>::unlink(Node* node, std::size_t index) {
+  Node* prev = node->prev();
+  Node* next = node->next();
+  T out_(std::move(node->data()));
+  if (prev != nullptr) {
+    prev->next(next);
+  } else {
+    head = next;
+  }
+  if (next != nullptr) {
+    next->prev(prev);
+    finger_ = next;
+    finger_index_ = index;
+  } else {
+    tail = prev;
+    finger_ = prev;
+    finger_index_ = index - 1;
+  }
+  delete_node(node);
+  size_--;
+  return out_;
+}
+/**
+ * Returns the node at a valid index. The walk starts from head, tail or the
+ * finger, whichever is closest, and the finger is left on the result.
+ * \param index position in [0, size()).
+ */
+template <typename T, typename Alloc>
+typename DoublyLinkedList<T, Alloc>::Node*
+DoublyLinkedList<T, Alloc>::node_at(std::size_t index) const {
+  Node* current = head;
+  std::size_t position = 0;
+  std::size_t distance = index;
+  if (size_ - 1 - index < distance) {
+    current = tail;
+    position = size_ - 1;
+    distance = size_ - 1 - index;
+  }
+  if (finger_ != nullptr) {
+    std::size_t from_finger = index > finger_index_ ? index - finger_index_
+                                                    : finger_index_ - index;
+    if (from_finger < distance) {
+      current = finger_;
+      position = finger_index_;
     }
-    delete first;
-    size_--;
-    return out_;
   }
+  for (; position < index; position++) {
+    current = current->next();
+  }
+  for (; position > index; position--) {
+    current = current->prev();
+  }
+  finger_ = current;
+  finger_index_ = index;
+  return current;
 }
 /**
  * Inserts an element in the specified location.
  * \param data data reference;
  * \param index index where the element will be put in.
  */
-template <typename T>
-void DoublyLinkedList<T>::insert(const T& data, std::size_t index) {
-  Node* input;
-  Node* prev;
-  Node* next;
+template <typename T, typename Alloc>
+void DoublyLinkedList<T, Alloc>::insert(const T& data, std::size_t index) {
+  if (index > size()) {
+    throw std::out_of_range("Index inválido");
+  }
+  link(new_node(data), index);
+}
+/**
+ * Inserts an element in the specified location, moving it in.
+ * \param data data to be moved;
+ * \param index index where the element will be put in.
+ */
+template <typename T, typename Alloc>
+void DoublyLinkedList<T, Alloc>::insert(T&& data, std::size_t index) {
   if (index > size()) {
     throw std::out_of_range("Index inválido");
-  } else if (index == 0) {
-    push_front(data);
-  } else {
-    input = new Node(data);
-    if (input == nullptr) {
-      throw std::out_of_range("Lista cheia.");
-    }
-    prev = head;
-    for (int i = 0; i < index - 1; i++) {
-      prev = prev->next();
-    }
-    next = prev->next();
-    input->next(next);
-    if (next != nullptr) {
-      next->prev(input);
-    }
-    input->prev(prev);
-    prev->next(input);
-    size_++;
   }
+  link(new_node(std::move(data)), index);
 }
 /**
  * Takes an element out by its index.
  * \param index element index.
  */
-template <typename T>
-T DoublyLinkedList<T>::pop(std::size_t index) {
-  T output_;
-  Node* popped;
-  Node* prev;
-  Node* next;
+template <typename T, typename Alloc>
+T DoublyLinkedList<T, Alloc>::pop(std::size_t index) {
   if (empty()) {
     throw std::out_of_range("Lista vazia");
   } else if (index > size() - 1) {
     throw std::out_of_range("Parâmetro inválido");
-  } else if (index == 0) {
-    return pop_front();
   } else {
-    prev = head;
-    for (int i = 0; i < index - 1; i++) {
-      prev = prev->next();
-    }
-    popped = prev->next();
-    next = popped->next();
-    output_ = popped->data();
-    prev->next(next);
-    if (next != nullptr) {
-      next->prev(prev);
-    }
-    size_--;
-    delete popped;
-    return output_;
+    return unlink(node_at(index), index);
   }
 }
 /**
  * Inserts an element respecting a specific progression.
  * \param data data.
  */
-template <typename T>
-void DoublyLinkedList<T>::insert_sorted(const T& data) {
+template <typename T, typename Alloc>
+void DoublyLinkedList<T, Alloc>::insert_sorted(const T& data) {
   Node* current;
   if (empty()) {
     push_front(data);
@@ -228,50 +528,102 @@ void DoublyLinkedList<T>::insert_sorted(const T& data) {
 /**
  * Adds an element to the end of the list.
  */
-template <typename T>
-void DoublyLinkedList<T>::push_back(const T& data) {
-  insert(data, size());
+template <typename T, typename Alloc>
+void DoublyLinkedList<T, Alloc>::push_back(const T& data) {
+  link(new_node(data), size());
+}
+/**
+ * Adds an element to the end of the list, moving it in.
+ */
+template <typename T, typename Alloc>
+void DoublyLinkedList<T, Alloc>::push_back(T&& data) {
+  link(new_node(std::move(data)), size());
+}
+/**
+ * Builds an element at the end of the list from constructor arguments.
+ */
+template <typename T, typename Alloc>
+template <typename... Args>
+void DoublyLinkedList<T, Alloc>::emplace_back(Args&&... args) {
+  link(new_node(InPlace{}, std::forward<Args>(args)...), size());
 }
 /**
  * Removes the last element.
  */
-template <typename T>
-T DoublyLinkedList<T>::pop_back() {
-  return pop(size() - 1);
+template <typename T, typename Alloc>
+T DoublyLinkedList<T, Alloc>::pop_back() {
+  if (empty()) {
+    throw std::out_of_range("Lista vazia");
+  }
+  return unlink(tail, size_ - 1);
 }
 /**
  * Returns a reference to the element at the specified index.
  */
-template <typename T>
-T& DoublyLinkedList<T>::at(std::size_t index) {
-  Node* current;
-  if (index > size() - 1) {
+template <typename T, typename Alloc>
+T& DoublyLinkedList<T, Alloc>::at(std::size_t index) {
+  if (index >= size()) {
     throw std::out_of_range("Index inválido");
-  } else if (index == 0) {
-    current = head;
-    return current->data();
-  } else {
-    current = head;
-    for (int i = 0; i < index; i++) {
-      current = current->next();
-    }
-    return current->data();
   }
+  return node_at(index)->data();
 }
 /**
  * Returns a reference to the element at the specified index.
  */
-template <typename T>
-const T& DoublyLinkedList<T>::at(std::size_t index) const {
-  return at(index);
+template <typename T, typename Alloc>
+const T& DoublyLinkedList<T, Alloc>::at(std::size_t index) const {
+  if (index >= size()) {
+    throw std::out_of_range("Index inválido");
+  }
+  return node_at(index)->data();
+}
+/**
+ * Returns a reference to the first element.
+ */
+template <typename T, typename Alloc>
+T& DoublyLinkedList<T, Alloc>::front() {
+  if (empty()) {
+    throw std::out_of_range("Lista vazia");
+  }
+  return head->data();
+}
+/**
+ * Returns a reference to the first element.
+ */
+template <typename T, typename Alloc>
+const T& DoublyLinkedList<T, Alloc>::front() const {
+  if (empty()) {
+    throw std::out_of_range("Lista vazia");
+  }
+  return head->data();
+}
+/**
+ * Returns a reference to the last element.
+ */
+template <typename T, typename Alloc>
+T& DoublyLinkedList<T, Alloc>::back() {
+  if (empty()) {
+    throw std::out_of_range("Lista vazia");
+  }
+  return tail->data();
+}
+/**
+ * Returns a reference to the last element.
+ */
+template <typename T, typename Alloc>
+const T& DoublyLinkedList<T, Alloc>::back() const {
+  if (empty()) {
+    throw std::out_of_range("Lista vazia");
+  }
+  return tail->data();
 }
 /**
  * Checks if the list has a certain element, and if so, returns its index.
  * \return specified element index.
  */
-template <typename T>
-std::size_t DoublyLinkedList<T>::find(const T& data) const {
-  Node* current = head;
+template <typename T, typename Alloc>
+std::size_t DoublyLinkedList<T, Alloc>::find(const T& data) const {
+  const Node* current = head;
   std::size_t index = size();
   for (std::size_t i = 0; i < size(); i++) {
     if (current->data() == data) {
@@ -288,8 +640,8 @@ std::size_t DoublyLinkedList<T>::find(const T& data) const {
  * Removes an element by its content.
  * \param data data.
  */
-template <typename T>
-void DoublyLinkedList<T>::remove(const T& data) {
+template <typename T, typename Alloc>
+void DoublyLinkedList<T, Alloc>::remove(const T& data) {
   std::size_t test = find(data);
   if (test != size()) {
     pop(test);
@@ -299,17 +651,363 @@ void DoublyLinkedList<T>::remove(const T& data) {
  * Checks if the list contains a certain element by its content.
  * \return boolean
  */
-template <typename T>
-bool DoublyLinkedList<T>::contains(const T& data) const {
+template <typename T, typename Alloc>
+bool DoublyLinkedList<T, Alloc>::contains(const T& data) const {
   return find(data) != size();
 }
 /**
  * Returns the list current size.
  */
-template <typename T>
-std::size_t DoublyLinkedList<T>::size() const {
+template <typename T, typename Alloc>
+std::size_t DoublyLinkedList<T, Alloc>::size() const {
   return size_;
 }
+/**
+ * Returns an iterator to the first element.
+ */
+template <typename T, typename Alloc>
+typename DoublyLinkedList<T, Alloc>::iterator
+DoublyLinkedList<T, Alloc>::begin() {
+  return iterator(head, this);
+}
+/**
+ * Returns an iterator to the first element.
+ */
+template <typename T, typename Alloc>
+typename DoublyLinkedList<T, Alloc>::const_iterator
+DoublyLinkedList<T, Alloc>::begin() const {
+  return const_iterator(head, this);
+}
+/**
+ * Returns an iterator to the first element.
+ */
+template <typename T, typename Alloc>
+typename DoublyLinkedList<T, Alloc>::const_iterator
+DoublyLinkedList<T, Alloc>::cbegin() const {
+  return begin();
+}
+/**
+ * Returns the past-the-end iterator.
+ */
+template <typename T, typename Alloc>
+typename DoublyLinkedList<T, Alloc>::iterator
+DoublyLinkedList<T, Alloc>::end() {
+  return iterator(nullptr, this);
+}
+/**
+ * Returns the past-the-end iterator.
+ */
+template <typename T, typename Alloc>
+typename DoublyLinkedList<T, Alloc>::const_iterator
+DoublyLinkedList<T, Alloc>::end() const {
+  return const_iterator(nullptr, this);
+}
+/**
+ * Returns the past-the-end iterator.
+ */
+template <typename T, typename Alloc>
+typename DoublyLinkedList<T, Alloc>::const_iterator
+DoublyLinkedList<T, Alloc>::cend() const {
+  return end();
+}
+/**
+ * Inserts an element right after the one at pos.
+ * \param pos dereferenceable iterator;
+ * \param data data reference.
+ * \return iterator to the new element.
+ */
+template <typename T, typename Alloc>
+typename DoublyLinkedList<T, Alloc>::iterator
+DoublyLinkedList<T, Alloc>::insert_after(const_iterator pos, const T& data) {
+  if (pos.node_ == nullptr) {
+    throw std::out_of_range("Index inválido");
+  }
+  Node* node = new_node(data);
+  attach(pos.node_->next(), node, node, 1);
+  return iterator(node, this);
+}
+/**
+ * Inserts an element right after the one at pos, moving it in.
+ * \param pos dereferenceable iterator;
+ * \param data data to be moved.
+ * \return iterator to the new element.
+ */
+template <typename T, typename Alloc>
+typename DoublyLinkedList<T, Alloc>::iterator
+DoublyLinkedList<T, Alloc>::insert_after(const_iterator pos, T&& data) {
+  if (pos.node_ == nullptr) {
+    throw std::out_of_range("Index inválido");
+  }
+  Node* node = new_node(std::move(data));
+  attach(pos.node_->next(), node, node, 1);
+  return iterator(node, this);
+}
+/**
+ * Removes the element at pos.
+ * \param pos dereferenceable iterator.
+ * \return iterator to the element that followed it.
+ */
+template <typename T, typename Alloc>
+typename DoublyLinkedList<T, Alloc>::iterator
+DoublyLinkedList<T, Alloc>::erase(const_iterator pos) {
+  if (pos.node_ == nullptr) {
+    throw std::out_of_range("Index inválido");
+  }
+  Node* next = pos.node_->next();
+  detach(pos.node_, pos.node_, 1);
+  delete_node(pos.node_);
+  return iterator(next, this);
+}
+/**
+ * Moves every element of other before pos, in O(1).
+ * \param pos iterator into this list;
+ * \param other list with an equal allocator; left empty.
+ */
+template <typename T, typename Alloc>
+void DoublyLinkedList<T, Alloc>::splice(const_iterator pos,
+                                        DoublyLinkedList& other) {
+  if (&other == this || other.empty()) {
+    return;
+  }
+  check_splice(other);
+  Node* first = other.head;
+  Node* last = other.tail;
+  std::size_t count = other.size_;
+  other.detach(first, last, count);
+  attach(pos.node_, first, last, count);
+}
+/**
+ * Moves the element at it, from other (which may be this list), before
+ * pos, in O(1).
+ * \param pos iterator into this list;
+ * \param other list that holds it;
+ * \param it dereferenceable iterator into other.
+ */
+template <typename T, typename Alloc>
+void DoublyLinkedList<T, Alloc>::splice(const_iterator pos,
+                                        DoublyLinkedList& other,
+                                        const_iterator it) {
+  if (&other == this &&
+      (it.node_ == pos.node_ || it.node_->next() == pos.node_)) {
+    return;
+  }
+  check_splice(other);
+  other.detach(it.node_, it.node_, 1);
+  attach(pos.node_, it.node_, it.node_, 1);
+}
+/**
+ * Moves the elements in [first, last), from other (which may be this list,
+ * as long as pos is outside the range), before pos. Within the same list
+ * this is O(1); otherwise the moved elements are counted.
+ * \param pos iterator into this list;
+ * \param other list that holds the range;
+ * \param first first element to move;
+ * \param last element after the last one to move.
+ */
+template <typename T, typename Alloc>
+void DoublyLinkedList<T, Alloc>::splice(const_iterator pos,
+                                        DoublyLinkedList& other,
+                                        const_iterator first,
+                                        const_iterator last) {
+  if (first == last || (&other == this && last == pos)) {
+    return;
+  }
+  check_splice(other);
+  std::size_t count = 0;
+  if (&other != this) {
+    for (const_iterator it = first; it != last; ++it) {
+      count++;
+    }
+  }
+  Node* back = (--last).node_;
+  other.detach(first.node_, back, count);
+  attach(pos.node_, first.node_, back, count);
+}
+/**
+ * Links the chain first..last (already linked among themselves) before
+ * next, or at the end when next is nullptr.
+ * \param count number of nodes in the chain, added to size().
+ */
+template <typename T, typename Alloc>
+void DoublyLinkedList<T, Alloc>::attach(Node* next, Node* first, Node* last,
+                                        std::size_t count) {
+  Node* prev = next == nullptr ? tail : next->prev();
+  first->prev(prev);
+  last->next(next);
+  if (prev != nullptr) {
+    prev->next(first);
+  } else {
+    head = first;
+  }
+  if (next != nullptr) {
+    next->prev(last);
+  } else {
+    tail = last;
+  }
+  size_ += count;
+  finger_ = nullptr;
+}
+/**
+ * Unlinks the chain first..last without freeing it.
+ * \param count number of nodes in the chain, taken from size().
+ */
+template <typename T, typename Alloc>
+void DoublyLinkedList<T, Alloc>::detach(Node* first, Node* last,
+                                        std::size_t count) {
+  Node* prev = first->prev();
+  Node* next = last->next();
+  if (prev != nullptr) {
+    prev->next(next);
+  } else {
+    head = next;
+  }
+  if (next != nullptr) {
+    next->prev(prev);
+  } else {
+    tail = prev;
+  }
+  size_ -= count;
+  finger_ = nullptr;
+}
+/**
+ * Sorts the list in ascending order (operator<).
+ */
+template <typename T, typename Alloc>
+void DoublyLinkedList<T, Alloc>::sort() {
+  sort([](const T& a, const T& b) { return a < b; });
+}
+/**
+ * Sorts the list with a bottom-up merge sort that only relinks nodes: it is
+ * stable, allocates nothing and uses O(1) extra space, in O(n log n).
+ * \param comp strict weak ordering, comp(a, b) true when a goes before b.
+ */
+template <typename T, typename Alloc>
+template <typename Compare>
+void DoublyLinkedList<T, Alloc>::sort(Compare comp) {
+  if (size_ < 2) {
+    return;
+  }
+  Node* list = head;
+  Node* last = nullptr;
+  for (std::size_t width = 1; width < size_; width *= 2) {
+    Node* left = list;
+    list = nullptr;
+    last = nullptr;
+    while (left != nullptr) {
+      // Merges the runs of up to width nodes at left and right.
+      Node* right = left;
+      std::size_t left_size = 0;
+      while (right != nullptr && left_size < width) {
+        right = right->next();
+        left_size++;
+      }
+      std::size_t right_size = width;
+      while (left_size > 0 || (right_size > 0 && right != nullptr)) {
+        Node* e;
+        if (left_size == 0) {
+          e = right;
+          right = right->next();
+          right_size--;
+        } else if (right_size == 0 || right == nullptr ||
+                   !comp(right->data(), left->data())) {
+          e = left;
+          left = left->next();
+          left_size--;
+        } else {
+          e = right;
+          right = right->next();
+          right_size--;
+        }
+        if (last == nullptr) {
+          list = e;
+        } else {
+          last->next(e);
+        }
+        e->prev(last);
+        last = e;
+      }
+      left = right;
+    }
+    last->next(nullptr);
+  }
+  head = list;
+  head->prev(nullptr);
+  tail = last;
+  finger_ = nullptr;
+}
+/**
+ * Merges other, sorted in ascending order (operator<), into this sorted
+ * list.
+ */
+template <typename T, typename Alloc>
+void DoublyLinkedList<T, Alloc>::merge(DoublyLinkedList& other) {
+  merge(other, [](const T& a, const T& b) { return a < b; });
+}
+/**
+ * Merges other into this list in linear time by relinking nodes. Both
+ * must be sorted by comp; equal elements of this list stay before those of
+ * other. other is left empty.
+ * \param other list with an equal allocator;
+ * \param comp ordering both lists are sorted by.
+ */
+template <typename T, typename Alloc>
+template <typename Compare>
+void DoublyLinkedList<T, Alloc>::merge(DoublyLinkedList& other, Compare comp) {
+  if (&other == this || other.empty()) {
+    return;
+  }
+  check_splice(other);
+  Node* a = head;
+  Node* b = other.head;
+  Node* list = nullptr;
+  Node* last = nullptr;
+  while (a != nullptr && b != nullptr) {
+    Node* e;
+    if (comp(b->data(), a->data())) {
+      e = b;
+      b = b->next();
+    } else {
+      e = a;
+      a = a->next();
+    }
+    if (last == nullptr) {
+      list = e;
+    } else {
+      last->next(e);
+    }
+    e->prev(last);
+    last = e;
+  }
+  Node* rest = a != nullptr ? a : b;
+  if (last == nullptr) {
+    list = rest;
+  } else {
+    last->next(rest);
+    rest->prev(last);
+  }
+  if (b != nullptr) {
+    tail = other.tail;
+  }
+  head = list;
+  head->prev(nullptr);
+  size_ += other.size_;
+  finger_ = nullptr;
+  other.head = nullptr;
+  other.tail = nullptr;
+  other.size_ = 0;
+  other.finger_ = nullptr;
+}
+/**
+ * Nodes can only move between lists whose allocators can free each
+ * other's nodes.
+ */
+template <typename T, typename Alloc>
+void DoublyLinkedList<T, Alloc>::check_splice(
+    const DoublyLinkedList& other) const {
+  if (node_alloc_ != other.node_alloc_) {
+    throw std::invalid_argument("Alocadores diferentes");
+  }
+}
 }  // namespace structures
 
 #endif
@@ -1,30 +1,79 @@
 // Copyright 2017 Eduardo Kohler
 
-#ifndef STRUCTURES_ARRAY_LIST_H
-#define STRUCTURES_ARRAY_LIST_H
+#ifndef STRUCTURES_CIRCULAR_LIST_H
+#define STRUCTURES_CIRCULAR_LIST_H
 
-#include <cstdint>    // std::size_t
-#include <stdexcept>  // C++ Exceptions
+#include <cstddef>      // std::ptrdiff_t
+#include <cstdint>      // std::size_t
+#include <iterator>     // std::forward_iterator_tag
+#include <memory>       // std::allocator, std::allocator_traits
+#include <stdexcept>    // C++ Exceptions
+#include <type_traits>  // std::conditional, std::is_trivially_destructible
+#include <utility>      // std::forward, std::move, std::swap
+
+#include "../memoria/node_pool.h"
 
 namespace structures {
 /**
  * Implementation of a template circular linked list.
+ *
+ * Nodes are obtained from Alloc (e.g. PoolAllocator<T>). The list is
+ * anchored on its last node, whose successor is the first one, so both
+ * ends are reached in O(1).
+ *
+ * For round-robin use the first element is the cursor: current() reads
+ * it, rotate() and advance(k) move the anchor forward (so indexes are
+ * relative to the cursor) and pop_current() takes it out, none of them
+ * touching the allocator.
+ *
+ * Iterators run once around the list, from the first node to the tail.
+ * Each one keeps the node before its position and how many steps it is
+ * from begin(), so insert_after, erase and every form of splice are O(1).
+ * Changing the list invalidates all iterators except the one returned,
+ * end() included.
  */
-template <typename T>
+template <typename T, typename Alloc = std::allocator<T>>
 class CircularList {
  public:
+  template <bool Const>
+  class Iterator;
+  using iterator = Iterator<false>;
+  using const_iterator = Iterator<true>;
+
   CircularList();
+  CircularList(const CircularList& other);             // cópia
+  CircularList(CircularList&& other);                  // movimento
+  CircularList& operator=(const CircularList& other);  // atribuição (cópia)
+  CircularList& operator=(CircularList&& other);       // atribuição (mov.)
   ~CircularList();
 
-  void clear();  // limpar lista
+  void clear();                    // limpar lista
+  void swap(CircularList& other);  // trocar conteúdo com outra lista
 
   void push_back(const T& data);                  // inserir no fim
+  void push_back(T&& data);                       // inserir no fim (mov.)
   void push_front(const T& data);                 // inserir no início
+  void push_front(T&& data);                      // inserir no início (mov.)
+  template <typename... Args>
+  void emplace_back(Args&&... args);              // construir no fim
+  template <typename... Args>
+  void emplace_front(Args&&... args);             // construir no início
   void insert(const T& data, std::size_t index);  // inserir na posição
+  void insert(T&& data, std::size_t index);       // inserir na posição (mov.)
   void insert_sorted(const T& data);              // inserir em ordem
 
   T& at(std::size_t index);  // acessar em um indice (com checagem de limites)
   const T& at(std::size_t index) const;  // versão const do acesso ao indice
+  T& front();                            // primeiro elemento
+  const T& front() const;                // primeiro elemento (const)
+  T& back();                             // último elemento
+  const T& back() const;                 // último elemento (const)
+
+  T& current();                     // elemento no cursor (o primeiro)
+  const T& current() const;         // elemento no cursor (const)
+  void rotate();                    // avança o cursor uma posição
+  void advance(std::size_t steps);  // avança o cursor steps posições
+  T pop_current();                  // retira o elemento no cursor
 
   T pop(std::size_t index);    // retirar da posição
   T pop_back();                // retirar do fim
@@ -37,11 +86,37 @@ class CircularList {
 
   std::size_t size() const;  // tamanho da lista
 
+  iterator begin();               // primeiro elemento
+  const_iterator begin() const;   // primeiro elemento (const)
+  const_iterator cbegin() const;  // primeiro elemento (const)
+  iterator end();                 // após o último elemento
+  const_iterator end() const;     // após o último elemento (const)
+  const_iterator cend() const;    // após o último elemento (const)
+
+  // inserir após a posição
+  iterator insert_after(const_iterator pos, const T& data);
+  iterator insert_after(const_iterator pos, T&& data);
+  // remover na posição
+  iterator erase(const_iterator pos);
+  // mover elementos de outra lista (ou desta) para antes da posição
+  void splice(const_iterator pos, CircularList& other);
+  void splice(const_iterator pos, CircularList& other, const_iterator it);
+  void splice(const_iterator pos, CircularList& other, const_iterator first,
+              const_iterator last);
+
  private:
+  struct InPlace {};  // marca: construir o dado a partir dos argumentos
+
   class Node {
    public:
     explicit Node(const T& data) : data_{data} {}
 
+    explicit Node(T&& data) : data_{std::move(data)} {}
+
+    template <typename... Args>
+    explicit Node(InPlace, Args&&... args)
+        : data_(std::forward<Args>(args)...) {}
+
     Node(const T& data, Node* next) : data_{data}, next_{next} {}
 
     T& data() { return data_; }
@@ -59,117 +134,301 @@ class CircularList {
     Node* next_{nullptr};
   };
 
-  Node* end() {
-    auto it = head;
-    for (auto i = 1u; i < size(); ++i) {
-      it = it->next();
+  using NodeAlloc =
+      typename std::allocator_traits<Alloc>::template rebind_alloc<Node>;
+  using NodeTraits = std::allocator_traits<NodeAlloc>;
+
+  template <typename... Args>
+  Node* new_node(Args&&... args) {
+    Node* node = NodeTraits::allocate(node_alloc_, 1);
+    try {
+      NodeTraits::construct(node_alloc_, node, std::forward<Args>(args)...);
+    } catch (...) {
+      NodeTraits::deallocate(node_alloc_, node, 1);
+      throw;
     }
-    return it;
+    return node;
+  }
+
+  void delete_node(Node* node) {
+    NodeTraits::destroy(node_alloc_, node);
+    NodeTraits::deallocate(node_alloc_, node, 1);
   }
-  Node* head{nullptr};
+
+  void link(Node* node, std::size_t index);
+
+  Node* before(std::size_t index) const;
+  Node* splice_point(const_iterator pos, bool at_end) const;
+  void attach(Node* prev, Node* first, Node* last, std::size_t count,
+              bool at_end);
+  void detach(Node* prev, Node* last, std::size_t count);
+  void check_splice(const CircularList& other) const;
+
+  Node* tail{nullptr};  // último nodo; tail->next() é o primeiro
   std::size_t size_{0u};
+  NodeAlloc node_alloc_;
+};
+/**
+ * Forward iterator over a CircularList. It holds the node before its
+ * position (the tail, for the first element) and its distance from
+ * begin(); end() is one full lap, so iterators are compared by distance.
+ */
+template <typename T, typename Alloc>
+template <bool Const>
+class CircularList<T, Alloc>::Iterator {
+ public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = T;
+  using difference_type = std::ptrdiff_t;
+  using pointer = typename std::conditional<Const, const T*, T*>::type;
+  using reference = typename std::conditional<Const, const T&, T&>::type;
+
+  Iterator() = default;
+
+  template <bool C, typename = typename std::enable_if<Const && !C>::type>
+  Iterator(const Iterator<C>& other)  // NOLINT(runtime/explicit)
+      : prev_{other.prev_}, step_{other.step_} {}
+
+  reference operator*() const { return prev_->next()->data(); }
+
+  pointer operator->() const { return &prev_->next()->data(); }
+
+  Iterator& operator++() {
+    prev_ = prev_->next();
+    step_++;
+    return *this;
+  }
+
+  Iterator operator++(int) {
+    Iterator old = *this;
+    ++*this;
+    return old;
+  }
+
+  bool operator==(const Iterator& other) const { return step_ == other.step_; }
+
+  bool operator!=(const Iterator& other) const { return step_ != other.step_; }
+
+ private:
+  friend class CircularList;
+  friend class Iterator<!Const>;
+
+  Iterator(Node* prev, std::size_t step) : prev_{prev}, step_{step} {}
+
+  Node* prev_{nullptr};
+  std::size_t step_{0u};
 };
 /**
  * Constructor. Sets the attributes values.
  */
-template <typename T>
-CircularList<T>::CircularList() {
+template <typename T, typename Alloc>
+CircularList<T, Alloc>::CircularList() {
   size_ = 0;
 }
+/**
+ * Copy constructor. Copies every element of other, in order.
+ */
+template <typename T, typename Alloc>
+CircularList<T, Alloc>::CircularList(const CircularList& other)
+    : node_alloc_{NodeTraits::select_on_container_copy_construction(
+          other.node_alloc_)} {
+  const Node* it = other.empty() ? nullptr : other.tail->next();
+  try {
+    for (std::size_t i = 0; i < other.size_; i++, it = it->next()) {
+      link(new_node(it->data()), size_);
+    }
+  } catch (...) {
+    clear();
+    throw;
+  }
+}
+/**
+ * Move constructor. Takes the nodes of other, leaving it empty.
+ */
+template <typename T, typename Alloc>
+CircularList<T, Alloc>::CircularList(CircularList&& other)
+    : tail{other.tail}, size_{other.size_}, node_alloc_{other.node_alloc_} {
+  other.tail = nullptr;
+  other.size_ = 0;
+}
+/**
+ * Copy assignment.
+ */
+template <typename T, typename Alloc>
+CircularList<T, Alloc>& CircularList<T, Alloc>::operator=(
+    const CircularList& other) {
+  CircularList copy(other);
+  swap(copy);
+  return *this;
+}
+/**
+ * Move assignment. The previous elements are destroyed.
+ */
+template <typename T, typename Alloc>
+CircularList<T, Alloc>& CircularList<T, Alloc>::operator=(
+    CircularList&& other) {
+  CircularList moved(std::move(other));
+  swap(moved);
+  return *this;
+}
 /**
  * Destructor. Deletes the contents[] arrayhead.
  */
-template <typename T>
-CircularList<T>::~CircularList() {
+template <typename T, typename Alloc>
+CircularList<T, Alloc>::~CircularList() {
   clear();
 }
 /**
- * Clears the list.
+ * Clears the list. Nodes are destroyed in place, without copying their
+ * data out; with a PoolAllocator the whole pool is released at once.
  */
-template <typename T>
-void CircularList<T>::clear() {
-  while (!empty()) {
-    pop_front();
+template <typename T, typename Alloc>
+void CircularList<T, Alloc>::clear() {
+  bool bulk = BulkRelease<NodeAlloc>::available(node_alloc_);
+  if (size_ != 0 && (!bulk || !std::is_trivially_destructible<T>::value)) {
+    Node* current = tail->next();
+    for (std::size_t i = 0; i < size_; i++) {
+      Node* next = current->next();
+      if (bulk) {
+        NodeTraits::destroy(node_alloc_, current);
+      } else {
+        delete_node(current);
+      }
+      current = next;
+    }
+  }
+  if (bulk) {
+    BulkRelease<NodeAlloc>::release(node_alloc_);
   }
+  tail = nullptr;
+  size_ = 0;
+}
+/**
+ * Exchanges the contents of two lists in O(1).
+ */
+template <typename T, typename Alloc>
+void CircularList<T, Alloc>::swap(CircularList& other) {
+  std::swap(tail, other.tail);
+  std::swap(size_, other.size_);
+  std::swap(node_alloc_, other.node_alloc_);
 }
 /**
  * Checks if the list is empty.
  * \return boolean
  */
-template <typename T>
-bool CircularList<T>::empty() const {
+template <typename T, typename Alloc>
+bool CircularList<T, Alloc>::empty() const {
   return size_ == 0;
 }
 /**
  * Adds an element to the front of the list.
  */
-template <typename T>
-void CircularList<T>::push_front(const T& data) {
-  Node* first = new Node(data);
-  if (first == nullptr) {
-    throw std::out_of_range("Lista cheia.");
-  } else {
-    if (empty()) {
-      first->next(first);
-    } else {
-      first->next(head);
-      Node* prev = end();
-      prev->next(first);
-    }
-    head = first;
-    size_++;
-  }
+template <typename T, typename Alloc>
+void CircularList<T, Alloc>::push_front(const T& data) {
+  link(new_node(data), 0);
+}
+/**
+ * Adds an element to the front of the list, moving it in.
+ */
+template <typename T, typename Alloc>
+void CircularList<T, Alloc>::push_front(T&& data) {
+  link(new_node(std::move(data)), 0);
+}
+/**
+ * Builds an element at the front of the list from constructor arguments.
+ */
+template <typename T, typename Alloc>
+template <typename... Args>
+void CircularList<T, Alloc>::emplace_front(Args&&... args) {
+  link(new_node(InPlace{}, std::forward<Args>(args)...), 0);
 }
 /**
  * Removes the first element.
  * \return The first element of type T.
  */
-template <typename T>
-T CircularList<T>::pop_front() {
+template <typename T, typename Alloc>
+T CircularList<T, Alloc>::pop_front() {
   if (empty()) {
     throw std::out_of_range("Lista vazia");
   } else {
-    Node* first = head;
-    Node* last = end();
-    T out_ = first->data();
-    head = first->next();
-    last->next(head);
-    delete first;
+    Node* first = tail->next();
+    T out_(std::move(first->data()));
+    if (first == tail) {
+      tail = nullptr;
+    } else {
+      tail->next(first->next());
+    }
+    delete_node(first);
     size_--;
     return out_;
   }
 }
+/**
+ * Links an already built node so that it ends up at the given index.
+ * \param node node to be linked;
+ * \param index valid position (at most size()).
+ */
+template <typename T, typename Alloc>
+void CircularList<T, Alloc>::link(Node* node, std::size_t index) {
+  if (empty()) {
+    node->next(node);
+    tail = node;
+  } else {
+    Node* prev = before(index);
+    node->next(prev->next());
+    prev->next(node);
+    if (index == size_) {
+      tail = node;
+    }
+  }
+  size_++;
+}
+/**
+ * Returns the node that precedes the given index: the tail for index 0 or
+ * size(), otherwise a walk from the first node.
+ * \param index position in [0, size()]; the list must not be empty.
+ */
+template <typename T, typename Alloc>
+typename CircularList<T, Alloc>::Node* CircularList<T, Alloc>::before(
+    std::size_t index) const {
+  Node* prev = tail;
+  if (index != size_) {
+    for (std::size_t i = 0; i < index; i++) {
+      prev = prev->next();
+    }
+  }
+  return prev;
+}
 /**
  * Inserts an element in the specified location.
  * \param data data reference;
  * \param index index where the element will be put in.
  */
-template <typename T>
-void CircularList<T>::insert(const T& data, std::size_t index) {
+template <typename T, typename Alloc>
+void CircularList<T, Alloc>::insert(const T& data, std::size_t index) {
+  if (index > size()) {
+    throw std::out_of_range("Index inválido");
+  }
+  link(new_node(data), index);
+}
+/**
+ * Inserts an element in the specified location, moving it in.
+ * \param data data to be moved;
+ * \param index index where the element will be put in.
+ */
+template <typename T, typename Alloc>
+void CircularList<T, Alloc>::insert(T&& data, std::size_t index) {
   if (index > size()) {
     throw std::out_of_range("Index inválido");
-  } else if (index == 0) {
-    push_front(data);
-  } else {
-    Node* input = new Node(data);
-    if (input == nullptr) {
-      throw std::out_of_range("Lista cheia.");
-    }
-    Node* prev = head;
-    for (int i = 0; i < index - 1; i++) {
-      prev = prev->next();
-    }
-    input->next(prev->next());
-    prev->next(input);
-    size_++;
   }
+  link(new_node(std::move(data)), index);
 }
 /**
  * Takes an element out by its index.
  * \param index element index.
  */
-template <typename T>
-T CircularList<T>::pop(std::size_t index) {
+template <typename T, typename Alloc>
+T CircularList<T, Alloc>::pop(std::size_t index) {
   if (empty()) {
     throw std::out_of_range("Lista vazia");
   } else if (index > size() - 1) {
@@ -177,15 +436,15 @@ T CircularList<T>::pop(std::size_t index) {
   } else if (index == 0) {
     return pop_front();
   } else {
-    Node* prev = head;
-    for (int i = 0; i < index - 1; i++) {
-      prev = prev->next();
-    }
+    Node* prev = before(index);
     Node* popped = prev->next();
-    T output_ = popped->data();
+    T output_(std::move(popped->data()));
     prev->next(popped->next());
+    if (popped == tail) {
+      tail = prev;
+    }
     size_--;
-    delete popped;
+    delete_node(popped);
     return output_;
   }
 }
@@ -193,12 +452,12 @@ T CircularList<T>::pop(std::size_t index) {
  * Inserts an element respecting a specific progression.
  * \param data data.
  */
-template <typename T>
-void CircularList<T>::insert_sorted(const T& data) {
+template <typename T, typename Alloc>
+void CircularList<T, Alloc>::insert_sorted(const T& data) {
   if (empty()) {
     push_front(data);
   } else {
-    Node* current = head;
+    Node* current = tail->next();
     std::size_t pos;
     for (pos = 0; pos < size() && data > current->data(); pos++) {
       current = current->next();
@@ -209,48 +468,146 @@ void CircularList<T>::insert_sorted(const T& data) {
 /**
  * Adds an element to the end of the list.
  */
-template <typename T>
-void CircularList<T>::push_back(const T& data) {
+template <typename T, typename Alloc>
+void CircularList<T, Alloc>::push_back(const T& data) {
   insert(data, size());
 }
+/**
+ * Adds an element to the end of the list, moving it in.
+ */
+template <typename T, typename Alloc>
+void CircularList<T, Alloc>::push_back(T&& data) {
+  insert(std::move(data), size());
+}
+/**
+ * Builds an element at the end of the list from constructor arguments.
+ */
+template <typename T, typename Alloc>
+template <typename... Args>
+void CircularList<T, Alloc>::emplace_back(Args&&... args) {
+  link(new_node(InPlace{}, std::forward<Args>(args)...), size());
+}
 /**
  * Removes the last element.
  */
-template <typename T>
-T CircularList<T>::pop_back() {
+template <typename T, typename Alloc>
+T CircularList<T, Alloc>::pop_back() {
   return pop(size() - 1);
 }
 /**
  * Returns a reference to the element at the specified index.
  */
-template <typename T>
-T& CircularList<T>::at(std::size_t index) {
-  Node* current = head;
-  if (index > size() - 1) {
+template <typename T, typename Alloc>
+T& CircularList<T, Alloc>::at(std::size_t index) {
+  if (index >= size()) {
     throw std::out_of_range("Index inválido");
-  } else if (index == 0) {
-    return current->data();
-  } else {
-    for (int i = 0; i < index; i++) {
-      current = current->next();
-    }
-    return current->data();
   }
+  return before(index)->next()->data();
 }
 /**
  * Returns a reference to the element at the specified index.
  */
-template <typename T>
-const T& CircularList<T>::at(std::size_t index) const {
-  return at(index);
+template <typename T, typename Alloc>
+const T& CircularList<T, Alloc>::at(std::size_t index) const {
+  if (index >= size()) {
+    throw std::out_of_range("Index inválido");
+  }
+  return before(index)->next()->data();
+}
+/**
+ * Returns a reference to the first element.
+ */
+template <typename T, typename Alloc>
+T& CircularList<T, Alloc>::front() {
+  if (empty()) {
+    throw std::out_of_range("Lista vazia");
+  }
+  return tail->next()->data();
+}
+/**
+ * Returns a reference to the first element.
+ */
+template <typename T, typename Alloc>
+const T& CircularList<T, Alloc>::front() const {
+  if (empty()) {
+    throw std::out_of_range("Lista vazia");
+  }
+  return tail->next()->data();
+}
+/**
+ * Returns a reference to the last element.
+ */
+template <typename T, typename Alloc>
+T& CircularList<T, Alloc>::back() {
+  if (empty()) {
+    throw std::out_of_range("Lista vazia");
+  }
+  return tail->data();
+}
+/**
+ * Returns a reference to the last element.
+ */
+template <typename T, typename Alloc>
+const T& CircularList<T, Alloc>::back() const {
+  if (empty()) {
+    throw std::out_of_range("Lista vazia");
+  }
+  return tail->data();
+}
+/**
+ * Returns a reference to the element at the cursor (the first one).
+ */
+template <typename T, typename Alloc>
+T& CircularList<T, Alloc>::current() {
+  return front();
+}
+/**
+ * Returns a reference to the element at the cursor (the first one).
+ */
+template <typename T, typename Alloc>
+const T& CircularList<T, Alloc>::current() const {
+  return front();
+}
+/**
+ * Moves the cursor to the next element in O(1): the current one becomes
+ * the last.
+ */
+template <typename T, typename Alloc>
+void CircularList<T, Alloc>::rotate() {
+  if (empty()) {
+    throw std::out_of_range("Lista vazia");
+  }
+  tail = tail->next();
+}
+/**
+ * Moves the cursor steps elements forward, in O(steps mod size()).
+ * \param steps number of elements to skip.
+ */
+template <typename T, typename Alloc>
+void CircularList<T, Alloc>::advance(std::size_t steps) {
+  if (empty()) {
+    throw std::out_of_range("Lista vazia");
+  }
+  for (steps %= size_; steps > 0; steps--) {
+    tail = tail->next();
+  }
+}
+/**
+ * Removes the element at the cursor in O(1); the cursor moves to the next
+ * one.
+ * \return the removed element.
+ */
+template <typename T, typename Alloc>
+T CircularList<T, Alloc>::pop_current() {
+  return pop_front();
 }
 /**
  * Checks if the list has a certain element, and if so, returns its index.
  * \return specified element index.
  */
-template <typename T>
-std::size_t CircularList<T>::find(const T& data) const {
-  Node* current = head;
+template <typename T, typename Alloc>
+std::size_t CircularList<T, Alloc>::find(const T& data) const {
+  const Node* current = empty() ? nullptr : tail->next();
   std::size_t index = size();
   for (std::size_t i = 0; i < size(); i++) {
     if (current->data() == data) {
@@ -266,8 +623,8 @@ std::size_t CircularList<T>::find(const T& data) const {
  * Removes an element by its content.
  * \param data data.
  */
-template <typename T>
-void CircularList<T>::remove(const T& data) {
+template <typename T, typename Alloc>
+void CircularList<T, Alloc>::remove(const T& data) {
   std::size_t test = find(data);
   if (test != size()) {
     pop(test);
@@ -277,16 +634,234 @@ void CircularList<T>::remove(const T& data) {
  * Checks if the list contains a certain element by its content.
  * \return boolean
  */
-template <typename T>
-bool CircularList<T>::contains(const T& data) const {
+template <typename T, typename Alloc>
+bool CircularList<T, Alloc>::contains(const T& data) const {
   return find(data) != size();
 }
 /**
  * Returns the list current size.
  */
-template <typename T>
-std::size_t CircularList<T>::size() const {
+template <typename T, typename Alloc>
+std::size_t CircularList<T, Alloc>::size() const {
   return size_;
 }
+/**
+ * Returns an iterator to the first element.
+ */
+template <typename T, typename Alloc>
+typename CircularList<T, Alloc>::iterator CircularList<T, Alloc>::begin() {
+  return iterator(tail, 0);
+}
+/**
+ * Returns an iterator to the first element.
+ */
+template <typename T, typename Alloc>
+typename CircularList<T, Alloc>::const_iterator CircularList<T, Alloc>::begin()
+    const {
+  return const_iterator(tail, 0);
+}
+/**
+ * Returns an iterator to the first element.
+ */
+template <typename T, typename Alloc>
+typename CircularList<T, Alloc>::const_iterator
+CircularList<T, Alloc>::cbegin() const {
+  return begin();
+}
+/**
+ * Returns the past-the-end iterator, one lap after begin().
+ */
+template <typename T, typename Alloc>
+typename CircularList<T, Alloc>::iterator CircularList<T, Alloc>::end() {
+  return iterator(tail, size_);
+}
+/**
+ * Returns the past-the-end iterator, one lap after begin().
+ */
+template <typename T, typename Alloc>
+typename CircularList<T, Alloc>::const_iterator CircularList<T, Alloc>::end()
+    const {
+  return const_iterator(tail, size_);
+}
+/**
+ * Returns the past-the-end iterator, one lap after begin().
+ */
+template <typename T, typename Alloc>
+typename CircularList<T, Alloc>::const_iterator CircularList<T, Alloc>::cend()
+    const {
+  return end();
+}
+/**
+ * Inserts an element right after the one at pos.
+ * \param pos dereferenceable iterator;
+ * \param data data reference.
+ * \return iterator to the new element.
+ */
+template <typename T, typename Alloc>
+typename CircularList<T, Alloc>::iterator CircularList<T, Alloc>::insert_after(
+    const_iterator pos, const T& data) {
+  if (pos.step_ >= size_) {
+    throw std::out_of_range("Index inválido");
+  }
+  Node* current = pos.prev_->next();
+  Node* node = new_node(data);
+  attach(current, node, node, 1, current == tail);
+  return iterator(current, pos.step_ + 1);
+}
+/**
+ * Inserts an element right after the one at pos, moving it in.
+ * \param pos dereferenceable iterator;
+ * \param data data to be moved.
+ * \return iterator to the new element.
+ */
+template <typename T, typename Alloc>
+typename CircularList<T, Alloc>::iterator CircularList<T, Alloc>::insert_after(
+    const_iterator pos, T&& data) {
+  if (pos.step_ >= size_) {
+    throw std::out_of_range("Index inválido");
+  }
+  Node* current = pos.prev_->next();
+  Node* node = new_node(std::move(data));
+  attach(current, node, node, 1, current == tail);
+  return iterator(current, pos.step_ + 1);
+}
+/**
+ * Removes the element at pos.
+ * \param pos dereferenceable iterator.
+ * \return iterator to the element that followed it (end() if it was the
+ * last one).
+ */
+template <typename T, typename Alloc>
+typename CircularList<T, Alloc>::iterator CircularList<T, Alloc>::erase(
+    const_iterator pos) {
+  if (pos.step_ >= size_) {
+    throw std::out_of_range("Index inválido");
+  }
+  Node* node = pos.prev_->next();
+  detach(pos.prev_, node, 1);
+  delete_node(node);
+  return empty() ? end() : iterator(pos.prev_, pos.step_);
+}
+/**
+ * Moves every element of other before pos, in O(1).
+ * \param pos iterator into this list;
+ * \param other list with an equal allocator; left empty.
+ */
+template <typename T, typename Alloc>
+void CircularList<T, Alloc>::splice(const_iterator pos, CircularList& other) {
+  if (&other == this || other.empty()) {
+    return;
+  }
+  check_splice(other);
+  bool at_end = pos.step_ == size_;
+  Node* first = other.tail->next();
+  Node* last = other.tail;
+  std::size_t count = other.size_;
+  other.detach(last, last, count);
+  attach(splice_point(pos, at_end), first, last, count, at_end);
+}
+/**
+ * Moves the element at it, from other (which may be this list), before
+ * pos, in O(1).
+ * \param pos iterator into this list;
+ * \param other list that holds it;
+ * \param it dereferenceable iterator into other.
+ */
+template <typename T, typename Alloc>
+void CircularList<T, Alloc>::splice(const_iterator pos, CircularList& other,
+                                    const_iterator it) {
+  if (&other == this &&
+      (pos.step_ == it.step_ || pos.step_ == it.step_ + 1)) {
+    return;
+  }
+  check_splice(other);
+  bool at_end = pos.step_ == size_;
+  Node* node = it.prev_->next();
+  other.detach(it.prev_, node, 1);
+  attach(splice_point(pos, at_end), node, node, 1, at_end);
+}
+/**
+ * Moves the elements in [first, last), from other (which may be this list,
+ * as long as pos is outside the range), before pos, in O(1).
+ * \param pos iterator into this list;
+ * \param other list that holds the range;
+ * \param first first element to move;
+ * \param last element after the last one to move.
+ */
+template <typename T, typename Alloc>
+void CircularList<T, Alloc>::splice(const_iterator pos, CircularList& other,
+                                    const_iterator first,
+                                    const_iterator last) {
+  if (first == last || (&other == this && pos.step_ >= first.step_ &&
+                        pos.step_ <= last.step_)) {
+    return;
+  }
+  check_splice(other);
+  bool at_end = pos.step_ == size_;
+  Node* front = first.prev_->next();
+  Node* back = last.prev_;
+  std::size_t count = last.step_ - first.step_;
+  other.detach(first.prev_, back, count);
+  attach(splice_point(pos, at_end), front, back, count, at_end);
+}
+/**
+ * Node after which a spliced chain goes. Must be called after detaching
+ * the chain: at either end of the list it is the current tail, which the
+ * detach may have changed.
+ */
+template <typename T, typename Alloc>
+typename CircularList<T, Alloc>::Node* CircularList<T, Alloc>::splice_point(
+    const_iterator pos, bool at_end) const {
+  return pos.step_ == 0 || at_end ? tail : pos.prev_;
+}
+/**
+ * Links the chain first..last after prev. In an empty list the chain
+ * closes on itself.
+ * \param count number of nodes in the chain, added to size();
+ * \param at_end whether last becomes the new tail.
+ */
+template <typename T, typename Alloc>
+void CircularList<T, Alloc>::attach(Node* prev, Node* first, Node* last,
+                                    std::size_t count, bool at_end) {
+  if (tail == nullptr) {
+    last->next(first);
+    tail = last;
+  } else {
+    last->next(prev->next());
+    prev->next(first);
+    if (at_end) {
+      tail = last;
+    }
+  }
+  size_ += count;
+}
+/**
+ * Unlinks the chain that starts after prev and ends at last, without
+ * freeing it.
+ * \param count number of nodes in the chain, taken from size().
+ */
+template <typename T, typename Alloc>
+void CircularList<T, Alloc>::detach(Node* prev, Node* last,
+                                    std::size_t count) {
+  if (count == size_) {
+    tail = nullptr;
+  } else {
+    prev->next(last->next());
+    if (last == tail) {
+      tail = prev;
+    }
+  }
+  size_ -= count;
+}
+/**
+ * Nodes can only move between lists whose allocators can free each
+ * other's nodes.
+ */
+template <typename T, typename Alloc>
+void CircularList<T, Alloc>::check_splice(const CircularList& other) const {
+  if (node_alloc_ != other.node_alloc_) {
+    throw std::invalid_argument("Alocadores diferentes");
+  }
+}
 }  // namespace structures
 #endif
@@ -0,0 +1,133 @@
+// Copyright 2017 Eduardo Kohler
+
+#ifndef STRUCTURES_WEIGHTED_ROUND_ROBIN_H
+#define STRUCTURES_WEIGHTED_ROUND_ROBIN_H
+
+#include <cstdint>  // std::size_t
+#include <memory>   // std::allocator
+#include <utility>  // std::move
+
+#include "./circular_list.h"
+
+namespace structures {
+/**
+ * Implementation of a template weighted round-robin scheduler.
+ *
+ * The entries sit in a CircularList whose cursor marks the one being
+ * served. next() hands out the current entry weight(entry) times in a row
+ * (at least once) before rotating to the following one, so a cycle costs
+ * O(1) per pick and never moves an entry between nodes.
+ *
+ * Weight is any callable taking const T& and returning the entry's share;
+ * it is read when the entry's turn starts, so changing a weight applies
+ * from the next turn on.
+ */
+template <typename T, typename Weight, typename Alloc = std::allocator<T>>
+class WeightedRoundRobin {
+ public:
+  explicit WeightedRoundRobin(Weight weight = Weight());
+
+  void add(const T& data);  // inserir antes do cursor (fim da rodada)
+  void add(T&& data);       // inserir antes do cursor (mov.)
+  T& next();                // escolher o próximo elemento
+  T& current();             // elemento no cursor
+  const T& current() const;
+  T pop_current();          // retirar o elemento no cursor
+  void clear();
+  bool empty() const;
+  std::size_t size() const;
+
+ private:
+  CircularList<T, Alloc> ring_;
+  Weight weight_;
+  std::size_t credit_{0u};  // picks left in the current turn
+};
+/**
+ * Constructor.
+ * \param weight callable giving the share of each entry.
+ */
+template <typename T, typename Weight, typename Alloc>
+WeightedRoundRobin<T, Weight, Alloc>::WeightedRoundRobin(Weight weight)
+    : weight_{std::move(weight)} {}
+/**
+ * Adds an entry; it is served last in the current round.
+ */
+template <typename T, typename Weight, typename Alloc>
+void WeightedRoundRobin<T, Weight, Alloc>::add(const T& data) {
+  ring_.push_back(data);
+}
+/**
+ * Adds an entry, moving it in.
+ */
+template <typename T, typename Weight, typename Alloc>
+void WeightedRoundRobin<T, Weight, Alloc>::add(T&& data) {
+  ring_.push_back(std::move(data));
+}
+/**
+ * Picks the next entry in O(1): the current one while its turn lasts,
+ * then the following one.
+ * \return reference to the picked entry, valid until it is removed.
+ */
+template <typename T, typename Weight, typename Alloc>
+T& WeightedRoundRobin<T, Weight, Alloc>::next() {
+  T& picked = ring_.current();
+  if (credit_ == 0) {
+    std::size_t weight = weight_(static_cast<const T&>(picked));
+    credit_ = weight == 0 ? 1 : weight;
+  }
+  if (--credit_ == 0) {
+    ring_.rotate();
+  }
+  return picked;
+}
+/**
+ * Returns the entry the next pick starts from.
+ */
+template <typename T, typename Weight, typename Alloc>
+T& WeightedRoundRobin<T, Weight, Alloc>::current() {
+  return ring_.current();
+}
+/**
+ * Returns the entry the next pick starts from.
+ */
+template <typename T, typename Weight, typename Alloc>
+const T& WeightedRoundRobin<T, Weight, Alloc>::current() const {
+  return ring_.current();
+}
+/**
+ * Removes the entry at the cursor in O(1); the following one starts a
+ * fresh turn.
+ * \return the removed entry.
+ */
+template <typename T, typename Weight, typename Alloc>
+T WeightedRoundRobin<T, Weight, Alloc>::pop_current() {
+  T popped = ring_.pop_current();
+  credit_ = 0;
+  return popped;
+}
+/**
+ * Removes every entry.
+ */
+template <typename T, typename Weight, typename Alloc>
+void WeightedRoundRobin<T, Weight, Alloc>::clear() {
+  ring_.clear();
+  credit_ = 0;
+}
+/**
+ * Checks if there are no entries.
+ * \return boolean
+ */
+template <typename T, typename Weight, typename Alloc>
+bool WeightedRoundRobin<T, Weight, Alloc>::empty() const {
+  return ring_.empty();
+}
+/**
+ * Returns the number of entries.
+ */
+template <typename T, typename Weight, typename Alloc>
+std::size_t WeightedRoundRobin<T, Weight, Alloc>::size() const {
+  return ring_.size();
+}
+}  // namespace structures
+
+#endif
@@ -1,26 +1,60 @@
 // Copyright 2017 Eduardo Kohler
 
-#ifndef STRUCTURES_ARRAY_LIST_H
-#define STRUCTURES_ARRAY_LIST_H
+#ifndef STRUCTURES_DOUBLY_CIRCULAR_LIST_H
+#define STRUCTURES_DOUBLY_CIRCULAR_LIST_H
 
-#include <cstdint>    // std::size_t
-#include <stdexcept>  // C++ Exceptions
+#include <cstddef>      // std::ptrdiff_t
+#include <cstdint>      // std::size_t
+#include <iterator>     // std::bidirectional_iterator_tag
+#include <memory>       // std::allocator, std::allocator_traits
+#include <stdexcept>    // C++ Exceptions
+#include <type_traits>  // std::conditional, std::is_trivially_destructible
+#include <utility>      // std::forward, std::move, std::swap
+
+#include "../memoria/node_pool.h"
 
 namespace structures {
 /**
  * Implementation of a template circular doubly linked list.
+ *
+ * Nodes are obtained from Alloc (e.g. PoolAllocator<T>). The last node is
+ * head->prev(), so both ends are O(1); positional operations walk from
+ * whichever end is closer to the index.
+ *
+ * Iterators are bidirectional and run once around the list. Each one also
+ * counts its steps from begin(), which is how end() (a full lap) is told
+ * apart from begin(). insert_after, erase and every form of splice are
+ * O(1); changing the list invalidates all iterators except the one
+ * returned, end() included.
  */
-template <typename T>
+template <typename T, typename Alloc = std::allocator<T>>
 class DoublyCircularList {
  public:
+  template <bool Const>
+  class Iterator;
+  using iterator = Iterator<false>;
+  using const_iterator = Iterator<true>;
+
   DoublyCircularList();
+  DoublyCircularList(const DoublyCircularList& other);
+  DoublyCircularList(DoublyCircularList&& other);
+  DoublyCircularList& operator=(const DoublyCircularList& other);
+  DoublyCircularList& operator=(DoublyCircularList&& other);
   ~DoublyCircularList();
 
   void clear();
+  void swap(DoublyCircularList& other);  // troca o conteúdo
 
   void push_back(const T& data);                  // insere no fim
+  void push_back(T&& data);                       // insere no fim (move)
   void push_front(const T& data);                 // insere no início
+  void push_front(T&& data);                      // insere no início (move)
+  template <typename... Args>
+  void emplace_back(Args&&... args);              // constrói no fim
+  template <typename... Args>
+  void emplace_front(Args&&... args);             // constrói no início
   void insert(const T& data, std::size_t index);  // insere na posição
+  void insert(T&& data, std::size_t index);       // insere na posição (move)
   void insert_sorted(const T& data);              // insere em ordem
 
   T pop(std::size_t index);    // retira da posição
@@ -33,14 +67,43 @@ class DoublyCircularList {
 
   T& at(std::size_t index);  // acesso a um elemento (checando limites)
   const T& at(std::size_t index) const;  // getter constante a um elemento
+  T& front();                            // primeiro elemento
+  const T& front() const;                // primeiro elemento (const)
+  T& back();                             // último elemento
+  const T& back() const;                 // último elemento (const)
 
   std::size_t find(const T& data) const;  // posição de um dado
   std::size_t size() const;               // tamanho
 
+  iterator begin();               // primeiro elemento
+  const_iterator begin() const;   // primeiro elemento (const)
+  const_iterator cbegin() const;  // primeiro elemento (const)
+  iterator end();                 // após o último elemento
+  const_iterator end() const;     // após o último elemento (const)
+  const_iterator cend() const;    // após o último elemento (const)
+
+  // insere após a posição
+  iterator insert_after(const_iterator pos, const T& data);
+  iterator insert_after(const_iterator pos, T&& data);
+  // retira da posição
+  iterator erase(const_iterator pos);
+  // move elementos de outra lista (ou desta) para antes da posição
+  void splice(const_iterator pos, DoublyCircularList& other);
+  void splice(const_iterator pos, DoublyCircularList& other,
+              const_iterator it);
+  void splice(const_iterator pos, DoublyCircularList& other,
+              const_iterator first, const_iterator last);
+
  private:
+  struct InPlace {};  // marca: constrói o dado a partir dos argumentos
+
   class Node {
    public:
     explicit Node(const T& data) : data_{data} {}
+    explicit Node(T&& data) : data_{std::move(data)} {}
+    template <typename... Args>
+    explicit Node(InPlace, Args&&... args)
+        : data_(std::forward<Args>(args)...) {}
     Node(const T& data, Node* next) : data_{data}, next_{next} {}
     Node(const T& data, Node* next, Node* prev)
         : data_{data}, next_{next}, prev_{prev} {}
@@ -62,150 +125,358 @@ class DoublyCircularList {
     Node* prev_{nullptr};
   };
 
-  Node* end() {
-    auto it = head;
-    for (auto i = 1u; i < size(); ++i) {
-      it = it->next();
+  using NodeAlloc =
+      typename std::allocator_traits<Alloc>::template rebind_alloc<Node>;
+  using NodeTraits = std::allocator_traits<NodeAlloc>;
+
+  template <typename... Args>
+  Node* new_node(Args&&... args) {
+    Node* node = NodeTraits::allocate(node_alloc_, 1);
+    try {
+      NodeTraits::construct(node_alloc_, node, std::forward<Args>(args)...);
+    } catch (...) {
+      NodeTraits::deallocate(node_alloc_, node, 1);
+      throw;
     }
-    return it;
+    return node;
   }
+
+  void delete_node(Node* node) {
+    NodeTraits::destroy(node_alloc_, node);
+    NodeTraits::deallocate(node_alloc_, node, 1);
+  }
+
+  void link(Node* node, std::size_t index);
+  T unlink(Node* node);
+  Node* node_at(std::size_t index) const;
+  Node* splice_point(const_iterator pos, bool at_end) const;
+  void attach(Node* next, Node* first, Node* last, std::size_t count,
+              bool at_begin);
+  void detach(Node* first, Node* last, std::size_t count);
+  void check_splice(const DoublyCircularList& other) const;
+
   Node* head{nullptr};
   std::size_t size_{0u};
+  NodeAlloc node_alloc_;
+};
+/**
+ * Bidirectional iterator over a DoublyCircularList. end() sits on head
+ * again after a full lap, so iterators are compared by their distance
+ * from begin().
+ */
+template <typename T, typename Alloc>
+template <bool Const>
+class DoublyCircularList<T, Alloc>::Iterator {
+ public:
+  using iterator_category = std::bidirectional_iterator_tag;
+  using value_type = T;
+  using difference_type = std::ptrdiff_t;
+  using pointer = typename std::conditional<Const, const T*, T*>::type;
+  using reference = typename std::conditional<Const, const T&, T&>::type;
+
+  Iterator() = default;
+
+  template <bool C, typename = typename std::enable_if<Const && !C>::type>
+  Iterator(const Iterator<C>& other)  // NOLINT(runtime/explicit)
+      : node_{other.node_}, step_{other.step_} {}
+
+  reference operator*() const { return node_->data(); }
+
+  pointer operator->() const { return &node_->data(); }
+
+  Iterator& operator++() {
+    node_ = node_->next();
+    step_++;
+    return *this;
+  }
+
+  Iterator operator++(int) {
+    Iterator old = *this;
+    ++*this;
+    return old;
+  }
+
+  Iterator& operator--() {
+    node_ = node_->prev();
+    step_--;
+    return *this;
+  }
+
+  Iterator operator--(int) {
+    Iterator old = *this;
+    --*this;
+    return old;
+  }
+
+  bool operator==(const Iterator& other) const { return step_ == other.step_; }
+
+  bool operator!=(const Iterator& other) const { return step_ != other.step_; }
+
+ private:
+  friend class DoublyCircularList;
+  friend class Iterator<!Const>;
+
+  Iterator(Node* node, std::size_t step) : node_{node}, step_{step} {}
+
+  Node* node_{nullptr};
+  std::size_t step_{0u};
 };
 /**
  * Constructor. Sets the attributes values.
  */
-template <typename T>
-DoublyCircularList<T>::DoublyCircularList() {
+template <typename T, typename Alloc>
+DoublyCircularList<T, Alloc>::DoublyCircularList() {
   size_ = 0;
 }
+/**
+ * Copy constructor. Copies every element of other, in order.
+ */
+template <typename T, typename Alloc>
+DoublyCircularList<T, Alloc>::DoublyCircularList(
+    const DoublyCircularList& other)
+    : node_alloc_{NodeTraits::select_on_container_copy_construction(
+          other.node_alloc_)} {
+  const Node* it = other.head;
+  try {
+    for (std::size_t i = 0; i < other.size_; i++, it = it->next()) {
+      Node* input = new_node(it->data());
+      if (head == nullptr) {
+        head = input;
+      } else {
+        Node* last = head->prev();
+        last->next(input);
+        input->prev(last);
+      }
+      input->next(head);
+      head->prev(input);
+      size_++;
+    }
+  } catch (...) {
+    clear();
+    throw;
+  }
+}
+/**
+ * Move constructor. Takes the nodes of other, leaving it empty.
+ */
+template <typename T, typename Alloc>
+DoublyCircularList<T, Alloc>::DoublyCircularList(DoublyCircularList&& other)
+    : head{other.head}, size_{other.size_}, node_alloc_{other.node_alloc_} {
+  other.head = nullptr;
+  other.size_ = 0;
+}
+/**
+ * Copy assignment.
+ */
+template <typename T, typename Alloc>
+DoublyCircularList<T, Alloc>& DoublyCircularList<T, Alloc>::operator=(
+    const DoublyCircularList& other) {
+  DoublyCircularList copy(other);
+  swap(copy);
+  return *this;
+}
+/**
+ * Move assignment. The previous elements are destroyed.
+ */
+template <typename T, typename Alloc>
+DoublyCircularList<T, Alloc>& DoublyCircularList<T, Alloc>::operator=(
+    DoublyCircularList&& other) {
+  DoublyCircularList moved(std::move(other));
+  swap(moved);
+  return *this;
+}
 /**
  * Destructor. Deletes the contents[] array.
  */
-template <typename T>
-DoublyCircularList<T>::~DoublyCircularList() {
+template <typename T, typename Alloc>
+DoublyCircularList<T, Alloc>::~DoublyCircularList() {
   clear();
 }
 /**
- * Clears the list.
+ * Clears the list. Nodes are destroyed in place, without copying their
+ * data out; with a PoolAllocator the whole pool is released at once.
  */
-template <typename T>
-void DoublyCircularList<T>::clear() {
-  while (!empty()) {
-    pop_front();
+template <typename T, typename Alloc>
+void DoublyCircularList<T, Alloc>::clear() {
+  bool bulk = BulkRelease<NodeAlloc>::available(node_alloc_);
+  if (!bulk || !std::is_trivially_destructible<T>::value) {
+    Node* current = head;
+    for (std::size_t i = 0; i < size_; i++) {
+      Node* next = current->next();
+      if (bulk) {
+        NodeTraits::destroy(node_alloc_, current);
+      } else {
+        delete_node(current);
+      }
+      current = next;
+    }
+  }
+  if (bulk) {
+    BulkRelease<NodeAlloc>::release(node_alloc_);
   }
+  head = nullptr;
+  size_ = 0;
+}
+/**
+ * Exchanges the contents of two lists in O(1).
+ */
+template <typename T, typename Alloc>
+void DoublyCircularList<T, Alloc>::swap(DoublyCircularList& other) {
+  std::swap(head, other.head);
+  std::swap(size_, other.size_);
+  std::swap(node_alloc_, other.node_alloc_);
 }
 /**
  * Checks if the list is empty.
  * \return boolean
  */
-template <typename T>
-bool DoublyCircularList<T>::empty() const {
+template <typename T, typename Alloc>
+bool DoublyCircularList<T, Alloc>::empty() const {
   return size_ == 0;
 }
 /**
  * Adds an element to the front of the list.
  */
-template <typename T>
-void DoublyCircularList<T>::push_front(const T& data) {
-  Node* first = new Node(data);
-  if (first == nullptr) {
-    throw std::out_of_range("Lista cheia.");
-  } else {
-    if (empty()) {
-      first->next(first);
-      first->prev(first);
-    } else {
-      Node* last = end();
-      first->next(head);
-      last->next(first);
-      first->prev(last);
-    }
-  }
-  head = first;
-  size_++;
+template <typename T, typename Alloc>
+void DoublyCircularList<T, Alloc>::push_front(const T& data) {
+  link(new_node(data), 0);
+}
+/**
+ * Adds an element to the front of the list, moving it in.
+ */
+template <typename T, typename Alloc>
+void DoublyCircularList<T, Alloc>::push_front(T&& data) {
+  link(new_node(std::move(data)), 0);
+}
+/**
+ * Builds an element at the front of the list from constructor arguments.
+ */
+template <typename T, typename Alloc>
+template <typename... Args>
+void DoublyCircularList<T, Alloc>::emplace_front(Args&&... args) {
+  link(new_node(InPlace{}, std::forward<Args>(args)...), 0);
 }
 /**
  * Removes the first element.
  * \return The first element of type T.
  */
-template <typename T>
-T DoublyCircularList<T>::pop_front() {
+template <typename T, typename Alloc>
+T DoublyCircularList<T, Alloc>::pop_front() {
   if (empty()) {
     throw std::out_of_range("Lista vazia");
   } else {
-    Node* first = head;
-    Node* last = first->prev();
-    T out_ = first->data();
-    head = first->next();
-    last->next(head);
-    head->prev(last);
-    delete first;
-    size_--;
-    return out_;
+    return unlink(head);
+  }
+}
+/**
+ * Links an already built node so that it ends up at the given index.
+ * \param node node to be linked;
+ * \param index valid position (at most size()).
+ */
+template <typename T, typename Alloc>
+void DoublyCircularList<T, Alloc>::link(Node* node, std::size_t index) {
+  if (empty()) {
+    node->next(node);
+    node->prev(node);
+    head = node;
+  } else {
+    Node* next = index == size_ ? head : node_at(index);
+    Node* prev = next->prev();
+    node->next(next);
+    node->prev(prev);
+    prev->next(node);
+    next->prev(node);
+    if (index == 0) {
+      head = node;
+    }
+  }
+  size_++;
+}
+/**
+ * Unlinks a node from the list and frees it.
+ * \param node node that belongs to this list.
+ * \return the data it held.
+ */
+template <typename T, typename Alloc>
+T DoublyCircularList<T, Alloc>::unlink(Node* node) {
+  T out_(std::move(node->data()));
+  if (size_ == 1) {
+    head = nullptr;
+  } else {
+    node->prev()->next(node->next());
+    node->next()->prev(node->prev());
+    if (node == head) {
+      head = node->next();
+    }
+  }
+  delete_node(node);
+  size_--;
+  return out_;
+}
+/**
+ * Returns the node at a valid index, walking forward from head or backward
+ * from the last node, whichever is closer.
+ * \param index position in [0, size()).
+ */
+template <typename T, typename Alloc>
+typename DoublyCircularList<T, Alloc>::Node*
+DoublyCircularList<T, Alloc>::node_at(std::size_t index) const {
+  Node* current = head;
+  if (index <= size_ / 2) {
+    for (std::size_t i = 0; i < index; i++) {
+      current = current->next();
+    }
+  } else {
+    for (std::size_t i = size_; i > index; i--) {
+      current = current->prev();
+    }
   }
+  return current;
 }
 /**
  * Inserts an element in the specified location.
  * \param data data reference;
  * \param index index where the element will be put in.
  */
-template <typename T>
-void DoublyCircularList<T>::insert(const T& data, std::size_t index) {
+template <typename T, typename Alloc>
+void DoublyCircularList<T, Alloc>::insert(const T& data, std::size_t index) {
   if (index > size()) {
     throw std::out_of_range("Index inválido");
-  } else if (index == 0) {
-    push_front(data);
-  } else {
-    Node* input = new Node(data);
-    if (input == nullptr) {
-      throw std::out_of_range("Lista cheia.");
-    }
-    Node* prev = head;
-    for (int i = 0; i < index - 1; i++) {
-      prev = prev->next();
-    }
-    Node* next = prev->next();
-    input->next(next);
-    next->prev(input);
-    input->prev(prev);
-    prev->next(input);
-    size_++;
   }
+  link(new_node(data), index);
+}
+/**
+ * Inserts an element in the specified location, moving it in.
+ * \param data data to be moved;
+ * \param index index where the element will be put in.
+ */
+template <typename T, typename Alloc>
+void DoublyCircularList<T, Alloc>::insert(T&& data, std::size_t index) {
+  if (index > size()) {
+    throw std::out_of_range("Index inválido");
+  }
+  link(new_node(std::move(data)), index);
 }
 /**
  * Takes an element out by its index.
  * \param index element index.
  */
-template <typename T>
-T DoublyCircularList<T>::pop(std::size_t index) {
+template <typename T, typename Alloc>
+T DoublyCircularList<T, Alloc>::pop(std::size_t index) {
   if (empty()) {
     throw std::out_of_range("Lista vazia");
   } else if (index > size() - 1) {
     throw std::out_of_range("Parâmetro inválido");
-  } else if (index == 0) {
-    return pop_front();
   } else {
-    Node* prev = head;
-    for (int i = 0; i < index - 1; i++) {
-      prev = prev->next();
-    }
-    Node* popped = prev->next();
-    Node* next = popped->next();
-    T output = popped->data();
-    prev->next(next);
-    next->prev(prev);
-    size_--;
-    delete popped;
-    return output;
+    return unlink(node_at(index));
   }
 }
 /**
  * Inserts an element respecting a specific progression.
  * \param data data.
  */
-template <typename T>
-void DoublyCircularList<T>::insert_sorted(const T& data) {
+template <typename T, typename Alloc>
+void DoublyCircularList<T, Alloc>::insert_sorted(const T& data) {
   if (empty()) {
     push_front(data);
   } else {
@@ -220,48 +491,102 @@ void DoublyCircularList<T>::insert_sorted(const T& data) {
 /**
  * Adds an element to the end of the list.
  */
-template <typename T>
-void DoublyCircularList<T>::push_back(const T& data) {
-  insert(data, size());
+template <typename T, typename Alloc>
+void DoublyCircularList<T, Alloc>::push_back(const T& data) {
+  link(new_node(data), size());
+}
+/**
+ * Adds an element to the end of the list, moving it in.
+ */
+template <typename T, typename Alloc>
+void DoublyCircularList<T, Alloc>::push_back(T&& data) {
+  link(new_node(std::move(data)), size());
+}
+/**
+ * Builds an element at the end of the list from constructor arguments.
+ */
+template <typename T, typename Alloc>
+template <typename... Args>
+void DoublyCircularList<T, Alloc>::emplace_back(Args&&... args) {
+  link(new_node(InPlace{}, std::forward<Args>(args)...), size());
 }
 /**
  * Removes the last element.
  */
-template <typename T>
-T DoublyCircularList<T>::pop_back() {
-  return pop(size() - 1);
+template <typename T, typename Alloc>
+T DoublyCircularList<T, Alloc>::pop_back() {
+  if (empty()) {
+    throw std::out_of_range("Lista vazia");
+  }
+  return unlink(head->prev());
 }
 /**
  * Returns a reference to the element at the specified index.
  */
-template <typename T>
-T& DoublyCircularList<T>::at(std::size_t index) {
-  Node* current = head;
-  if (index > size() - 1) {
+template <typename T, typename Alloc>
+T& DoublyCircularList<T, Alloc>::at(std::size_t index) {
+  if (index >= size()) {
     throw std::out_of_range("Index inválido");
-  } else if (index == 0) {
-    return current->data();
-  } else {
-    for (int i = 0; i < index; i++) {
-      current = current->next();
-    }
-    return current->data();
   }
+  return node_at(index)->data();
 }
 /**
  * Returns a reference to the element at the specified index.
  */
-template <typename T>
-const T& DoublyCircularList<T>::at(std::size_t index) const {
-  return at(index);
+template <typename T, typename Alloc>
+const T& DoublyCircularList<T, Alloc>::at(std::size_t index) const {
+  if (index >= size()) {
+    throw std::out_of_range("Index inválido");
+  }
+  return node_at(index)->data();
+}
+/**
+ * Returns a reference to the first element.
+ */
+template <typename T, typename Alloc>
+T& DoublyCircularList<T, Alloc>::front() {
+  if (empty()) {
+    throw std::out_of_range("Lista vazia");
+  }
+  return head->data();
+}
+/**
+ * Returns a reference to the first element.
+ */
+template <typename T, typename Alloc>
+const T& DoublyCircularList<T, Alloc>::front() const {
+  if (empty()) {
+    throw std::out_of_range("Lista vazia");
+  }
+  return head->data();
+}
+/**
+ * Returns a reference to the last element.
+ */
+template <typename T, typename Alloc>
+T& DoublyCircularList<T, Alloc>::back() {
+  if (empty()) {
+    throw std::out_of_range("Lista vazia");
+  }
+  return head->prev()->data();
+}
+/**
+ * Returns a reference to the last element.
+ */
+template <typename T, typename Alloc>
+const T& DoublyCircularList<T, Alloc>::back() const {
+  if (empty()) {
+    throw std::out_of_range("Lista vazia");
+  }
+  return head->prev()->data();
 }
 /**
  * Checks if the list has a certain element, and if so, returns its index.
  * \return specified element index.
  */
-template <typename T>
-std::size_t DoublyCircularList<T>::find(const T& data) const {
-  Node* current = head;
+template <typename T, typename Alloc>
+std::size_t DoublyCircularList<T, Alloc>::find(const T& data) const {
+  const Node* current = head;
   std::size_t index = size();
   for (std::size_t i = 0; i < size(); i++) {
     if (current->data() == data) {
@@ -277,8 +602,8 @@ std::size_t DoublyCircularList<T>::find(const T& data) const {
  * Removes an element by its content.
  * \param data data.
  */
-template <typename T>
-void DoublyCircularList<T>::remove(const T& data) {
+template <typename T, typename Alloc>
+void DoublyCircularList<T, Alloc>::remove(const T& data) {
   std::size_t test = find(data);
   if (test != size()) {
     pop(test);
@@ -288,16 +613,246 @@ void DoublyCircularList<T>::remove(const T& data) {
  * Checks if the list contains a certain element by its content.
  * \return boolean
  */
-template <typename T>
-bool DoublyCircularList<T>::contains(const T& data) const {
+template <typename T, typename Alloc>
+bool DoublyCircularList<T, Alloc>::contains(const T& data) const {
   return find(data) != size();
 }
 /**
  * Returns the list current size.
  */
-template <typename T>
-std::size_t DoublyCircularList<T>::size() const {
+template <typename T, typename Alloc>
+std::size_t DoublyCircularList<T, Alloc>::size() const {
   return size_;
 }
+/**
+ * Returns an iterator to the first element.
+ */
+template <typename T, typename Alloc>
+typename DoublyCircularList<T, Alloc>::iterator
+DoublyCircularList<T, Alloc>::begin() {
+  return iterator(head, 0);
+}
+/**
+ * Returns an iterator to the first element.
+ */
+template <typename T, typename Alloc>
+typename DoublyCircularList<T, Alloc>::const_iterator
+DoublyCircularList<T, Alloc>::begin() const {
+  return const_iterator(head, 0);
+}
+/**
+ * Returns an iterator to the first element.
+ */
+template <typename T, typename Alloc>
+typename DoublyCircularList<T, Alloc>::const_iterator
+DoublyCircularList<T, Alloc>::cbegin() const {
+  return begin();
+}
+/**
+ * Returns the past-the-end iterator, one lap after begin().
+ */
+template <typename T, typename Alloc>
+typename DoublyCircularList<T, Alloc>::iterator
+DoublyCircularList<T, Alloc>::end() {
+  return iterator(head, size_);
+}
+/**
+ * Returns the past-the-end iterator, one lap after begin().
+ */
+template <typename T, typename Alloc>
+typename DoublyCircularList<T, Alloc>::const_iterator
+DoublyCircularList<T, Alloc>::end() const {
+  return const_iterator(head, size_);
+}
+/**
+ * Returns the past-the-end iterator, one lap after begin().
+ */
+template <typename T, typename Alloc>
+typename DoublyCircularList<T, Alloc>::const_iterator
+DoublyCircularList<T, Alloc>::cend() const {
+  return end();
+}
+/**
+ * Inserts an element right after the one at pos.
+ * \param pos dereferenceable iterator;
+ * \param data data reference.
+ * \return iterator to the new element.
+ */
+template <typename T, typename Alloc>
+typename DoublyCircularList<T, Alloc>::iterator
+DoublyCircularList<T, Alloc>::insert_after(const_iterator pos,
+                                           const T& data) {
+  if (pos.step_ >= size_) {
+    throw std::out_of_range("Index inválido");
+  }
+  Node* node = new_node(data);
+  attach(pos.node_->next(), node, node, 1, false);
+  return iterator(node, pos.step_ + 1);
+}
+/**
+ * Inserts an element right after the one at pos, moving it in.
+ * \param pos dereferenceable iterator;
+ * \param data data to be moved.
+ * \return iterator to the new element.
+ */
+template <typename T, typename Alloc>
+typename DoublyCircularList<T, Alloc>::iterator
+DoublyCircularList<T, Alloc>::insert_after(const_iterator pos, T&& data) {
+  if (pos.step_ >= size_) {
+    throw std::out_of_range("Index inválido");
+  }
+  Node* node = new_node(std::move(data));
+  attach(pos.node_->next(), node, node, 1, false);
+  return iterator(node, pos.step_ + 1);
+}
+/**
+ * Removes the element at pos.
+ * \param pos dereferenceable iterator.
+ * \return iterator to the element that followed it (end() if it was the
+ * last one).
+ */
+template <typename T, typename Alloc>
+typename DoublyCircularList<T, Alloc>::iterator
+DoublyCircularList<T, Alloc>::erase(const_iterator pos) {
+  if (pos.step_ >= size_) {
+    throw std::out_of_range("Index inválido");
+  }
+  Node* next = pos.node_->next();
+  detach(pos.node_, pos.node_, 1);
+  delete_node(pos.node_);
+  return empty() ? end() : iterator(next, pos.step_);
+}
+/**
+ * Moves every element of other before pos, in O(1).
+ * \param pos iterator into this list;
+ * \param other list with an equal allocator; left empty.
+ */
+template <typename T, typename Alloc>
+void DoublyCircularList<T, Alloc>::splice(const_iterator pos,
+                                          DoublyCircularList& other) {
+  if (&other == this || other.empty()) {
+    return;
+  }
+  check_splice(other);
+  bool at_end = pos.step_ == size_;
+  Node* first = other.head;
+  Node* last = first->prev();
+  std::size_t count = other.size_;
+  other.detach(first, last, count);
+  attach(splice_point(pos, at_end), first, last, count, pos.step_ == 0);
+}
+/**
+ * Moves the element at it, from other (which may be this list), before
+ * pos, in O(1).
+ * \param pos iterator into this list;
+ * \param other list that holds it;
+ * \param it dereferenceable iterator into other.
+ */
+template <typename T, typename Alloc>
+void DoublyCircularList<T, Alloc>::splice(const_iterator pos,
+                                          DoublyCircularList& other,
+                                          const_iterator it) {
+  if (&other == this &&
+      (pos.step_ == it.step_ || pos.step_ == it.step_ + 1)) {
+    return;
+  }
+  check_splice(other);
+  bool at_end = pos.step_ == size_;
+  other.detach(it.node_, it.node_, 1);
+  attach(splice_point(pos, at_end), it.node_, it.node_, 1, pos.step_ == 0);
+}
+/**
+ * Moves the elements in [first, last), from other (which may be this list,
+ * as long as pos is outside the range), before pos, in O(1).
+ * \param pos iterator into this list;
+ * \param other list that holds the range;
+ * \param first first element to move;
+ * \param last element after the last one to move.
+ */
+template <typename T, typename Alloc>
+void DoublyCircularList<T, Alloc>::splice(const_iterator pos,
+                                          DoublyCircularList& other,
+                                          const_iterator first,
+                                          const_iterator last) {
+  if (first == last || (&other == this && pos.step_ >= first.step_ &&
+                        pos.step_ <= last.step_)) {
+    return;
+  }
+  check_splice(other);
+  bool at_end = pos.step_ == size_;
+  Node* front = first.node_;
+  Node* back = last.node_->prev();
+  std::size_t count = last.step_ - first.step_;
+  other.detach(front, back, count);
+  attach(splice_point(pos, at_end), front, back, count, pos.step_ == 0);
+}
+/**
+ * Node before which a spliced chain goes. Must be called after detaching
+ * the chain: at either end of the list it is the current head, which the
+ * detach may have changed.
+ */
+template <typename T, typename Alloc>
+typename DoublyCircularList<T, Alloc>::Node*
+DoublyCircularList<T, Alloc>::splice_point(const_iterator pos,
+                                           bool at_end) const {
+  return pos.step_ == 0 || at_end ? head : pos.node_;
+}
+/**
+ * Links the chain first..last before next. In an empty list the chain
+ * closes on itself.
+ * \param count number of nodes in the chain, added to size();
+ * \param at_begin whether first becomes the new head.
+ */
+template <typename T, typename Alloc>
+void DoublyCircularList<T, Alloc>::attach(Node* next, Node* first,
+                                          Node* last, std::size_t count,
+                                          bool at_begin) {
+  if (head == nullptr) {
+    last->next(first);
+    first->prev(last);
+    head = first;
+  } else {
+    Node* prev = next->prev();
+    prev->next(first);
+    first->prev(prev);
+    last->next(next);
+    next->prev(last);
+    if (at_begin) {
+      head = first;
+    }
+  }
+  size_ += count;
+}
+/**
+ * Unlinks the chain first..last without freeing it.
+ * \param count number of nodes in the chain, taken from size().
+ */
+template <typename T, typename Alloc>
+void DoublyCircularList<T, Alloc>::detach(Node* first, Node* last,
+                                          std::size_t count) {
+  if (count == size_) {
+    head = nullptr;
+  } else {
+    Node* prev = first->prev();
+    Node* next = last->next();
+    prev->next(next);
+    next->prev(prev);
+    if (first == head) {
+      head = next;
+    }
+  }
+  size_ -= count;
+}
+/**
+ * Nodes can only move between lists whose allocators can free each
+ * other's nodes.
+ */
+template <typename T, typename Alloc>
+void DoublyCircularList<T, Alloc>::check_splice(
+    const DoublyCircularList& other) const {
+  if (node_alloc_ != other.node_alloc_) {
+    throw std::invalid_argument("Alocadores diferentes");
+  }
+}
 }  // namespace structures
 #endif
@@ -0,0 +1,303 @@
+// Copyright 2017 Eduardo Kohler
+
+#ifndef STRUCTURES_CONCURRENT_SKIP_LIST_H
+#define STRUCTURES_CONCURRENT_SKIP_LIST_H
+
+#include <atomic>   // std::atomic
+#include <cstdint>  // std::size_t, std::uint32_t
+#include <mutex>    // std::mutex, std::lock_guard
+#include <new>      // ::operator new
+#include <utility>  // std::forward, std::move
+
+#include "../fila-pilha-enc/hazard_pointers.h"
+
+namespace structures {
+/**
+ * Implementation of a template sorted set over a skip list, for many
+ * threads that mostly look elements up.
+ *
+ * contains and empty take no lock: a reader walks down the towers holding
+ * the node it stands on and the next one in its two hazard pointers.
+ * Writers (insert_sorted, remove, clear) are serialized by a mutex; a new
+ * node is linked bottom-up, so a reader either sees it or not, and a
+ * removed node is flagged, unlinked top-down and only deleted through
+ * HazardPointers once no reader holds it. A reader that finds the node it
+ * stands on flagged starts over from the head.
+ *
+ * Towers are drawn and laid out as in SkipList (inline links, 1/4 chance
+ * per extra level); positions are not tracked, so there is no find/at.
+ */
+template <typename T>
+class ConcurrentSkipList {
+ public:
+  static const std::size_t MAX_HEIGHT = 16;  // enough for 4^16 elements
+
+  ConcurrentSkipList();
+
+  ConcurrentSkipList(const ConcurrentSkipList&) = delete;
+
+  ConcurrentSkipList& operator=(const ConcurrentSkipList&) = delete;
+
+  ~ConcurrentSkipList();
+
+  void clear();
+
+  void insert_sorted(const T& data);
+
+  void insert_sorted(T&& data);
+
+  bool remove(const T& data);  // whether an element was removed
+
+  bool contains(const T& data) const;
+
+  bool empty() const;
+
+  std::size_t size() const;  // approximate while other threads write
+
+ private:
+  class Node {
+   public:
+    template <typename... Args>
+    static Node* create(std::size_t height, Args&&... args) {
+      static_assert(alignof(Node) % alignof(Link) == 0,
+                    "the tower must be aligned right after the node");
+      void* memory = ::operator new(sizeof(Node) + height * sizeof(Link));
+      try {
+        return new (memory) Node(height, std::forward<Args>(args)...);
+      } catch (...) {
+        ::operator delete(memory);
+        throw;
+      }
+    }
+
+    // The node is bigger than sizeof(Node): never pass the size along.
+    static void operator delete(void* pointer) { ::operator delete(pointer); }
+
+    const T& data() const { return data_; }
+
+    std::size_t height() const { return height_; }
+
+    /**
+     * The tower: height links stored right after the node.
+     */
+    std::atomic<Node*>* links() { return reinterpret_cast<Link*>(this + 1); }
+
+    bool removed() const { return removed_.load(); }
+
+    void remove() { removed_.store(true); }
+
+   private:
+    using Link = std::atomic<Node*>;
+
+    template <typename... Args>
+    explicit Node(std::size_t height, Args&&... args)
+        : data_(std::forward<Args>(args)...), height_{height} {
+      for (std::size_t level = 0; level < height; level++) {
+        new (&links()[level]) Link(nullptr);
+      }
+    }
+
+    T data_;
+    std::size_t height_;
+    std::atomic<bool> removed_{false};
+  };
+
+  std::size_t random_height();
+  void search(const T& data, std::atomic<Node*>** update);
+  void link(Node* node);
+
+  std::atomic<Node*> head_[MAX_HEIGHT];  // links before the first element
+  std::atomic<std::size_t> size_;
+  std::size_t height_{1};  // levels in use, guarded by mutex_
+  std::uint32_t seed_{2463534242u};
+  std::mutex mutex_;
+};
+/**
+ * Constructor. Sets the attributes values.
+ */
+template <typename T>
+ConcurrentSkipList<T>::ConcurrentSkipList() : size_{0} {
+  for (auto& link : head_) {
+    link.store(nullptr, std::memory_order_relaxed);
+  }
+}
+/**
+ * Destructor. No other thread may be using the list.
+ */
+template <typename T>
+ConcurrentSkipList<T>::~ConcurrentSkipList() {
+  Node* current = head_[0].load();
+  while (current != nullptr) {
+    Node* next = current->links()[0].load();
+    delete current;
+    current = next;
+  }
+}
+/**
+ * Clears the list. Readers still walking it finish on the old nodes.
+ */
+template <typename T>
+void ConcurrentSkipList<T>::clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Node* current = head_[0].load();
+  for (std::size_t level = height_; level-- > 0;) {
+    head_[level].store(nullptr);
+  }
+  while (current != nullptr) {
+    Node* next = current->links()[0].load();
+    current->remove();
+    HazardPointers::retire(current);
+    current = next;
+  }
+  size_.store(0);
+}
+/**
+ * Inserts an element before any equal ones, keeping the list sorted.
+ * \param data data reference.
+ */
+template <typename T>
+void ConcurrentSkipList<T>::insert_sorted(const T& data) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  link(Node::create(random_height(), data));
+}
+/**
+ * Inserts an element before any equal ones, moving it in.
+ * \param data data to be moved.
+ */
+template <typename T>
+void ConcurrentSkipList<T>::insert_sorted(T&& data) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  link(Node::create(random_height(), std::move(data)));
+}
+/**
+ * Removes the first element equal to data, if there is one.
+ * \param data data.
+ * \return whether an element was removed.
+ */
+template <typename T>
+bool ConcurrentSkipList<T>::remove(const T& data) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::atomic<Node*>* update[MAX_HEIGHT];
+  search(data, update);
+  Node* found = update[0][0].load();
+  if (found == nullptr || data < found->data()) {
+    return false;
+  }
+  found->remove();
+  for (std::size_t level = found->height(); level-- > 0;) {
+    update[level][level].store(found->links()[level].load());
+  }
+  size_.fetch_sub(1);
+  HazardPointers::retire(found);
+  return true;
+}
+/**
+ * Checks if the list contains a certain element by its content, without
+ * locking.
+ * \return boolean
+ */
+template <typename T>
+bool ConcurrentSkipList<T>::contains(const T& data) const {
+  for (;;) {
+    const std::atomic<Node*>* links = head_;
+    Node* previous = nullptr;
+    Node* current = nullptr;
+    std::size_t slot = 0;  // slot of current; previous is in the other one
+    bool restart = false;
+    for (std::size_t level = MAX_HEIGHT; level-- > 0 && !restart;) {
+      for (;;) {
+        current = HazardPointers::protect(slot, links[level]);
+        if (previous != nullptr && previous->removed()) {
+          // previous was unlinked: current may already be retired.
+          restart = true;
+          break;
+        }
+        if (current == nullptr || !(current->data() < data)) {
+          break;
+        }
+        previous = current;
+        links = current->links();
+        slot = 1 - slot;
+      }
+    }
+    if (!restart) {
+      bool found = current != nullptr && !(data < current->data());
+      HazardPointers::clear(0);
+      HazardPointers::clear(1);
+      return found;
+    }
+  }
+}
+/**
+ * Checks if the list is empty.
+ * \return boolean
+ */
+template <typename T>
+bool ConcurrentSkipList<T>::empty() const {
+  return head_[0].load() == nullptr;
+}
+/**
+ * Returns the list current size.
+ */
+template <typename T>
+std::size_t ConcurrentSkipList<T>::size() const {
+  return size_.load();
+}
+/**
+ * Draws a tower height: each extra level has probability 1/4 (xorshift).
+ * Called with mutex_ held.
+ */
+template <typename T>
+std::size_t ConcurrentSkipList<T>::random_height() {
+  seed_ ^= seed_ << 13;
+  seed_ ^= seed_ >> 17;
+  seed_ ^= seed_ << 5;
+  std::uint32_t bits = seed_;
+  std::size_t height = 1;
+  while (height < MAX_HEIGHT && (bits & 3u) == 0) {
+    height++;
+    bits >>= 2;
+  }
+  return height;
+}
+/**
+ * Fills update with, for every level in use, the tower whose link at that
+ * level is the last one before the first element not less than data.
+ * Called with mutex_ held, so no node in the way can be deleted.
+ */
+template <typename T>
+void ConcurrentSkipList<T>::search(const T& data,
+                                   std::atomic<Node*>** update) {
+  std::atomic<Node*>* links = head_;
+  for (std::size_t level = height_; level-- > 0;) {
+    Node* next = links[level].load();
+    while (next != nullptr && next->data() < data) {
+      links = next->links();
+      next = links[level].load();
+    }
+    update[level] = links;
+  }
+}
+/**
+ * Links a node bottom-up, so readers never reach it from above before it
+ * is in the bottom level. Called with mutex_ held.
+ */
+template <typename T>
+void ConcurrentSkipList<T>::link(Node* node) {
+  if (height_ < node->height()) {
+    height_ = node->height();
+  }
+  std::atomic<Node*>* update[MAX_HEIGHT];
+  search(node->data(), update);
+  for (std::size_t level = 0; level < node->height(); level++) {
+    node->links()[level].store(update[level][level].load(),
+                               std::memory_order_relaxed);
+  }
+  for (std::size_t level = 0; level < node->height(); level++) {
+    update[level][level].store(node);
+  }
+  size_.fetch_add(1);
+}
+}  // namespace structures
+
+#endif
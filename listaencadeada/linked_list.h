@@ -1,26 +1,60 @@
 // Copyright 2017 Eduardo Kohler
 
-#ifndef STRUCTURES_ARRAY_LIST_H
-#define STRUCTURES_ARRAY_LIST_H
+#ifndef STRUCTURES_LINKED_LIST_H
+#define STRUCTURES_LINKED_LIST_H
 
-#include <cstdint>    // std::size_t
-#include <stdexcept>  // C++ Exceptions
+#include <cstddef>      // std::ptrdiff_t
+#include <cstdint>      // std::size_t
+#include <iterator>     // std::forward_iterator_tag
+#include <memory>       // std::allocator, std::allocator_traits
+#include <stdexcept>    // C++ Exceptions
+#include <type_traits>  // std::conditional, std::is_trivially_destructible
+#include <utility>      // std::forward, std::move, std::swap
+
+#include "../memoria/node_pool.h"
 
 namespace structures {
 /**
  * Implementation of a template linked list.
+ *
+ * Nodes are obtained from Alloc (e.g. PoolAllocator<T>). The last node is
+ * cached, so push_back and back() are O(1).
+ *
+ * Iterators are forward iterators that also remember the previous node, so
+ * insert_after, erase and splice at an iterator are O(1) (a range splice
+ * from another list still counts its elements). Changing the list
+ * invalidates the iterators around the change, except the one returned.
  */
-template <typename T>
+template <typename T, typename Alloc = std::allocator<T>>
 class LinkedList {
  public:
+  template <bool Const>
+  class Iterator;
+  using iterator = Iterator<false>;
+  using const_iterator = Iterator<true>;
+
   LinkedList();
+  LinkedList(const LinkedList& other);
+  LinkedList(LinkedList&& other);
+  LinkedList& operator=(const LinkedList& other);
+  LinkedList& operator=(LinkedList&& other);
   ~LinkedList();
   void clear();
+  void swap(LinkedList& other);
   void push_back(const T& data);
+  void push_back(T&& data);
   void push_front(const T& data);
+  void push_front(T&& data);
+  template <typename... Args>
+  void emplace_back(Args&&... args);
+  template <typename... Args>
+  void emplace_front(Args&&... args);
   void insert(const T& data, std::size_t index);
+  void insert(T&& data, std::size_t index);
   void insert_sorted(const T& data);
   T& at(std::size_t index);
+  T& back();
+  const T& back() const;
   T pop(std::size_t index);
   T pop_back();
   T pop_front();
@@ -30,11 +64,39 @@ class LinkedList {
   std::size_t find(const T& data) const;
   std::size_t size() const;
 
+  iterator begin();
+  const_iterator begin() const;
+  const_iterator cbegin() const;
+  iterator end();
+  const_iterator end() const;
+  const_iterator cend() const;
+  iterator insert_after(const_iterator pos, const T& data);
+  iterator insert_after(const_iterator pos, T&& data);
+  iterator erase(const_iterator pos);
+  void splice(const_iterator pos, LinkedList& other);
+  void splice(const_iterator pos, LinkedList& other, const_iterator it);
+  void splice(const_iterator pos, LinkedList& other, const_iterator first,
+              const_iterator last);
+  void sort();
+  template <typename Compare>
+  void sort(Compare comp);
+  void merge(LinkedList& other);
+  template <typename Compare>
+  void merge(LinkedList& other, Compare comp);
+
  private:
+  struct InPlace {};  // tag: build the data from constructor arguments
+
   class Node {
    public:
     explicit Node(const T& data) : data_{data} {}
 
+    explicit Node(T&& data) : data_{std::move(data)} {}
+
+    template <typename... Args>
+    explicit Node(InPlace, Args&&... args)
+        : data_(std::forward<Args>(args)...) {}
+
     Node(const T& data, Node* next) : data_{data}, next_{next} {}
 
     T& data() { return data_; }
@@ -52,114 +114,302 @@ class LinkedList {
     Node* next_{nullptr};
   };
 
-  Node* end() {
-    auto it = head;
-    for (auto i = 1u; i < size(); ++i) {
-      it = it->next();
+  using NodeAlloc =
+      typename std::allocator_traits<Alloc>::template rebind_alloc<Node>;
+  using NodeTraits = std::allocator_traits<NodeAlloc>;
+
+  template <typename... Args>
+  Node* new_node(Args&&... args) {
+    Node* node = NodeTraits::allocate(node_alloc_, 1);
+    try {
+      NodeTraits::construct(node_alloc_, node, std::forward<Args>(args)...);
+    } catch (...) {
+      NodeTraits::deallocate(node_alloc_, node, 1);
+      throw;
     }
-    return it;
+    return node;
+  }
+
+  void delete_node(Node* node) {
+    NodeTraits::destroy(node_alloc_, node);
+    NodeTraits::deallocate(node_alloc_, node, 1);
   }
+
+  void link(Node* node, std::size_t index);
+  iterator link_after(Node* prev, Node* node);
+  void attach(Node* prev, Node* first, Node* last, std::size_t count);
+  void detach(Node* prev, Node* last, std::size_t count);
+  void check_splice(const LinkedList& other) const;
+
   Node* head{nullptr};
+  Node* tail{nullptr};
   std::size_t size_{0u};
+  NodeAlloc node_alloc_;
+};
+/**
+ * Forward iterator over a LinkedList. Besides the current node it keeps
+ * the previous one (nullptr at the first node), which is what makes
+ * erase and splice O(1) in a singly linked list.
+ */
+template <typename T, typename Alloc>
+template <bool Const>
+class LinkedList<T, Alloc>::Iterator {
+ public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = T;
+  using difference_type = std::ptrdiff_t;
+  using pointer = typename std::conditional<Const, const T*, T*>::type;
+  using reference = typename std::conditional<Const, const T&, T&>::type;
+
+  Iterator() = default;
+
+  template <bool C, typename = typename std::enable_if<Const && !C>::type>
+  Iterator(const Iterator<C>& other)  // NOLINT(runtime/explicit)
+      : prev_{other.prev_}, node_{other.node_} {}
+
+  reference operator*() const { return node_->data(); }
+
+  pointer operator->() const { return &node_->data(); }
+
+  Iterator& operator++() {
+    prev_ = node_;
+    node_ = node_->next();
+    return *this;
+  }
+
+  Iterator operator++(int) {
+    Iterator old = *this;
+    ++*this;
+    return old;
+  }
+
+  bool operator==(const Iterator& other) const { return node_ == other.node_; }
+
+  bool operator!=(const Iterator& other) const { return node_ != other.node_; }
+
+ private:
+  friend class LinkedList;
+  friend class Iterator<!Const>;
+
+  Iterator(Node* prev, Node* node) : prev_{prev}, node_{node} {}
+
+  Node* prev_{nullptr};
+  Node* node_{nullptr};
 };
 /**
  * Constructor. Sets the attributes values.
  */
-template <typename T>
-LinkedList<T>::LinkedList() {
+template <typename T, typename Alloc>
+LinkedList<T, Alloc>::LinkedList() {
   head = nullptr;
   size_ = 0;
 }
+/**
+ * Copy constructor. Copies every element of other, in order.
+ */
+template <typename T, typename Alloc>
+LinkedList<T, Alloc>::LinkedList(const LinkedList& other)
+    : node_alloc_{NodeTraits::select_on_container_copy_construction(
+          other.node_alloc_)} {
+  Node* last = nullptr;
+  try {
+    for (const Node* it = other.head; it != nullptr; it = it->next()) {
+      Node* input = new_node(it->data());
+      if (last == nullptr) {
+        head = input;
+      } else {
+        last->next(input);
+      }
+      last = input;
+      tail = input;
+      size_++;
+    }
+  } catch (...) {
+    clear();
+    throw;
+  }
+}
+/**
+ * Move constructor. Takes the nodes of other, leaving it empty.
+ */
+template <typename T, typename Alloc>
+LinkedList<T, Alloc>::LinkedList(LinkedList&& other)
+    : head{other.head},
+      tail{other.tail},
+      size_{other.size_},
+      node_alloc_{other.node_alloc_} {
+  other.head = nullptr;
+  other.tail = nullptr;
+  other.size_ = 0;
+}
+/**
+ * Copy assignment.
+ */
+template <typename T, typename Alloc>
+LinkedList<T, Alloc>& LinkedList<T, Alloc>::operator=(
+    const LinkedList& other) {
+  LinkedList copy(other);
+  swap(copy);
+  return *this;
+}
+/**
+ * Move assignment. The previous elements are destroyed.
+ */
+template <typename T, typename Alloc>
+LinkedList<T, Alloc>& LinkedList<T, Alloc>::operator=(LinkedList&& other) {
+  LinkedList moved(std::move(other));
+  swap(moved);
+  return *this;
+}
 /**
  * Destructor. Deletes the contents[] array.
  */
-template <typename T>
-LinkedList<T>::~LinkedList() {
+template <typename T, typename Alloc>
+LinkedList<T, Alloc>::~LinkedList() {
   clear();
 }
 /**
- * Clears the list.
+ * Clears the list. Nodes are destroyed in place, without copying their
+ * data out; with a PoolAllocator the whole pool is released at once.
  */
-template <typename T>
-void LinkedList<T>::clear() {
-  while (!empty()) {
-    pop_front();
+template <typename T, typename Alloc>
+void LinkedList<T, Alloc>::clear() {
+  bool bulk = BulkRelease<NodeAlloc>::available(node_alloc_);
+  if (!bulk || !std::is_trivially_destructible<T>::value) {
+    Node* current = head;
+    for (std::size_t i = 0; i < size_; i++) {
+      Node* next = current->next();
+      if (bulk) {
+        NodeTraits::destroy(node_alloc_, current);
+      } else {
+        delete_node(current);
+      }
+      current = next;
+    }
+  }
+  if (bulk) {
+    BulkRelease<NodeAlloc>::release(node_alloc_);
   }
+  head = nullptr;
+  tail = nullptr;
+  size_ = 0;
+}
+/**
+ * Exchanges the contents of two lists in O(1).
+ */
+template <typename T, typename Alloc>
+void LinkedList<T, Alloc>::swap(LinkedList& other) {
+  std::swap(head, other.head);
+  std::swap(tail, other.tail);
+  std::swap(size_, other.size_);
+  std::swap(node_alloc_, other.node_alloc_);
 }
 /**
  * Checks if the list is empty.
  * \return boolean
  */
-template <typename T>
-bool LinkedList<T>::empty() const {
+template <typename T, typename Alloc>
+bool LinkedList<T, Alloc>::empty() const {
   return size_ == 0;
 }
 /**
  * Adds an element to the front of the list.
  */
-template <typename T>
-void LinkedList<T>::push_front(const T& data) {
-  Node* first = new Node(data);
-  if (first == nullptr) {
-    throw std::out_of_range("Lista cheia.");
-  }
-  first->next(head);
-  head = first;
-  size_++;
+template <typename T, typename Alloc>
+void LinkedList<T, Alloc>::push_front(const T& data) {
+  link(new_node(data), 0);
+}
+/**
+ * Adds an element to the front of the list, moving it in.
+ */
+template <typename T, typename Alloc>
+void LinkedList<T, Alloc>::push_front(T&& data) {
+  link(new_node(std::move(data)), 0);
+}
+/**
+ * Builds an element at the front of the list from constructor arguments.
+ */
+template <typename T, typename Alloc>
+template <typename... Args>
+void LinkedList<T, Alloc>::emplace_front(Args&&... args) {
+  link(new_node(InPlace{}, std::forward<Args>(args)...), 0);
 }
 /**
  * Removes the first element.
  * \return The first element of type T.
  */
-template <typename T>
-T LinkedList<T>::pop_front() {
+template <typename T, typename Alloc>
+T LinkedList<T, Alloc>::pop_front() {
   if (empty()) {
     throw std::out_of_range("Lista vazia");
   } else {
     Node* first = head;
-    T out_ = first->data();
+    T out_(std::move(first->data()));
     head = first->next();
-    delete first;
+    if (head == nullptr) {
+      tail = nullptr;
+    }
+    delete_node(first);
     size_--;
     return out_;
   }
 }
+/**
+ * Links an already built node so that it ends up at the given index.
+ * \param node node to be linked;
+ * \param index valid position (at most size()).
+ */
+template <typename T, typename Alloc>
+void LinkedList<T, Alloc>::link(Node* node, std::size_t index) {
+  if (index == 0) {
+    node->next(head);
+    head = node;
+    if (tail == nullptr) {
+      tail = node;
+    }
+  } else if (index == size_) {
+    tail->next(node);
+    tail = node;
+  } else {
+    Node* prev = head;
+    for (std::size_t i = 0; i < index - 1; i++) {
+      prev = prev->next();
+    }
+    node->next(prev->next());
+    prev->next(node);
+  }
+  size_++;
+}
 /**
  * Inserts an element in the specified location.
  * \param data data reference;
  * \param index index where the element will be put in.
  */
-template <typename T>
-void LinkedList<T>::insert(const T& data, std::size_t index) {
-  Node* input;
-  Node* prev;
+template <typename T, typename Alloc>
+void LinkedList<T, Alloc>::insert(const T& data, std::size_t index) {
+  if (index > size()) {
+    throw std::out_of_range("Index inválido");
+  }
+  link(new_node(data), index);
+}
+/**
+ * Inserts an element in the specified location, moving it in.
+ * \param data data to be moved;
+ * \param index index where the element will be put in.
+ */
+template <typename T, typename Alloc>
+void LinkedList<T, Alloc>::insert(T&& data, std::size_t index) {
   if (index > size()) {
     throw std::out_of_range("Index inválido");
-  } else if (index == 0) {
-    push_front(data);
-  } else {
-    input = new Node(data);
-    if (input == nullptr) {
-      throw std::out_of_range("Lista cheia.");
-    }
-    prev = head;
-    for (int i = 0; i < index - 1; i++) {
-      prev = prev->next();
-    }
-    input->next(prev->next());
-    prev->next(input);
-    size_++;
   }
+  link(new_node(std::move(data)), index);
 }
 /**
  * Takes an element out by its index.
  * \param index element index.
  */
-template <typename T>
-T LinkedList<T>::pop(std::size_t index) {
-  T output_;
-  Node* popped;
-  Node* prev;
+template <typename T, typename Alloc>
+T LinkedList<T, Alloc>::pop(std::size_t index) {
   if (empty()) {
     throw std::out_of_range("Lista vazia");
   } else if (index > size() - 1) {
@@ -167,15 +417,18 @@ T LinkedList<T>::pop(std::size_t index) {
   } else if (index == 0) {
     return pop_front();
   } else {
-    prev = head;
-    for (int i = 0; i < index - 1; i++) {
+    Node* prev = head;
+    for (std::size_t i = 0; i < index - 1; i++) {
       prev = prev->next();
     }
-    popped = prev->next();
-    output_ = popped->data();
+    Node* popped = prev->next();
+    T output_(std::move(popped->data()));
     prev->next(popped->next());
+    if (popped == tail) {
+      tail = prev;
+    }
     size_--;
-    delete popped;
+    delete_node(popped);
     return output_;
   }
 }
@@ -183,8 +436,8 @@ T LinkedList<T>::pop(std::size_t index) {
  * Inserts an element respecting a specific progression.
  * \param data data.
  */
-template <typename T>
-void LinkedList<T>::insert_sorted(const T& data) {
+template <typename T, typename Alloc>
+void LinkedList<T, Alloc>::insert_sorted(const T& data) {
   Node* current;
   if (empty()) {
     push_front(data);
@@ -200,22 +453,37 @@ void LinkedList<T>::insert_sorted(const T& data) {
 /**
  * Adds an element to the end of the list.
  */
-template <typename T>
-void LinkedList<T>::push_back(const T& data) {
+template <typename T, typename Alloc>
+void LinkedList<T, Alloc>::push_back(const T& data) {
   insert(data, size());
 }
+/**
+ * Adds an element to the end of the list, moving it in.
+ */
+template <typename T, typename Alloc>
+void LinkedList<T, Alloc>::push_back(T&& data) {
+  insert(std::move(data), size());
+}
+/**
+ * Builds an element at the end of the list from constructor arguments.
+ */
+template <typename T, typename Alloc>
+template <typename... Args>
+void LinkedList<T, Alloc>::emplace_back(Args&&... args) {
+  link(new_node(InPlace{}, std::forward<Args>(args)...), size());
+}
 /**
  * Removes the last element.
  */
-template <typename T>
-T LinkedList<T>::pop_back() {
+template <typename T, typename Alloc>
+T LinkedList<T, Alloc>::pop_back() {
   return pop(size() - 1);
 }
 /**
  * Returns a reference to the element at the specified index.
  */
-template <typename T>
-T& LinkedList<T>::at(std::size_t index) {
+template <typename T, typename Alloc>
+T& LinkedList<T, Alloc>::at(std::size_t index) {
   Node* current;
   if (index > size() - 1) {
     throw std::out_of_range("Index inválido");
@@ -230,12 +498,32 @@ T& LinkedList<T>::at(std::size_t index) {
     return current->data();
   }
 }
+/**
+ * Returns a reference to the last element.
+ */
+template <typename T, typename Alloc>
+T& LinkedList<T, Alloc>::back() {
+  if (empty()) {
+    throw std::out_of_range("Lista vazia");
+  }
+  return tail->data();
+}
+/**
+ * Returns a reference to the last element.
+ */
+template <typename T, typename Alloc>
+const T& LinkedList<T, Alloc>::back() const {
+  if (empty()) {
+    throw std::out_of_range("Lista vazia");
+  }
+  return tail->data();
+}
 /**
  * Checks if the list has a certain element, and if so, returns its index.
  * \return specified element index.
  */
-template <typename T>
-std::size_t LinkedList<T>::find(const T& data) const {
+template <typename T, typename Alloc>
+std::size_t LinkedList<T, Alloc>::find(const T& data) const {
   Node* current = head;
   std::size_t index = size();
   for (std::size_t i = 0; i < size(); i++) {
@@ -253,8 +541,8 @@ std::size_t LinkedList<T>::find(const T& data) const {
  * Removes an element by its content.
  * \param data data.
  */
-template <typename T>
-void LinkedList<T>::remove(const T& data) {
+template <typename T, typename Alloc>
+void LinkedList<T, Alloc>::remove(const T& data) {
   std::size_t test = find(data);
   if (test != size()) {
     pop(test);
@@ -264,16 +552,343 @@ void LinkedList<T>::remove(const T& data) {
  * Checks if the list contains a certain element by its content.
  * \return boolean
  */
-template <typename T>
-bool LinkedList<T>::contains(const T& data) const {
+template <typename T, typename Alloc>
+bool LinkedList<T, Alloc>::contains(const T& data) const {
   return find(data) != size();
 }
 /**
  * Returns the list current size.
  */
-template <typename T>
-std::size_t LinkedList<T>::size() const {
+template <typename T, typename Alloc>
+std::size_t LinkedList<T, Alloc>::size() const {
   return size_;
 }
+/**
+ * Returns an iterator to the first element.
+ */
+template <typename T, typename Alloc>
+typename LinkedList<T, Alloc>::iterator LinkedList<T, Alloc>::begin() {
+  return iterator(nullptr, head);
+}
+/**
+ * Returns an iterator to the first element.
+ */
+template <typename T, typename Alloc>
+typename LinkedList<T, Alloc>::const_iterator LinkedList<T, Alloc>::begin()
+    const {
+  return const_iterator(nullptr, head);
+}
+/**
+ * Returns an iterator to the first element.
+ */
+template <typename T, typename Alloc>
+typename LinkedList<T, Alloc>::const_iterator LinkedList<T, Alloc>::cbegin()
+    const {
+  return begin();
+}
+/**
+ * Returns the past-the-end iterator. Its previous node is the tail, so
+ * splicing at end() appends in O(1).
+ */
+template <typename T, typename Alloc>
+typename LinkedList<T, Alloc>::iterator LinkedList<T, Alloc>::end() {
+  return iterator(tail, nullptr);
+}
+/**
+ * Returns the past-the-end iterator.
+ */
+template <typename T, typename Alloc>
+typename LinkedList<T, Alloc>::const_iterator LinkedList<T, Alloc>::end()
+    const {
+  return const_iterator(tail, nullptr);
+}
+/**
+ * Returns the past-the-end iterator.
+ */
+template <typename T, typename Alloc>
+typename LinkedList<T, Alloc>::const_iterator LinkedList<T, Alloc>::cend()
+    const {
+  return end();
+}
+/**
+ * Inserts an element right after the one at pos.
+ * \param pos dereferenceable iterator;
+ * \param data data reference.
+ * \return iterator to the new element.
+ */
+template <typename T, typename Alloc>
+typename LinkedList<T, Alloc>::iterator LinkedList<T, Alloc>::insert_after(
+    const_iterator pos, const T& data) {
+  if (pos.node_ == nullptr) {
+    throw std::out_of_range("Index inválido");
+  }
+  return link_after(pos.node_, new_node(data));
+}
+/**
+ * Inserts an element right after the one at pos, moving it in.
+ * \param pos dereferenceable iterator;
+ * \param data data to be moved.
+ * \return iterator to the new element.
+ */
+template <typename T, typename Alloc>
+typename LinkedList<T, Alloc>::iterator LinkedList<T, Alloc>::insert_after(
+    const_iterator pos, T&& data) {
+  if (pos.node_ == nullptr) {
+    throw std::out_of_range("Index inválido");
+  }
+  return link_after(pos.node_, new_node(std::move(data)));
+}
+/**
+ * Removes the element at pos.
+ * \param pos dereferenceable iterator.
+ * \return iterator to the element that followed it.
+ */
+template <typename T, typename Alloc>
+typename LinkedList<T, Alloc>::iterator LinkedList<T, Alloc>::erase(
+    const_iterator pos) {
+  if (pos.node_ == nullptr) {
+    throw std::out_of_range("Index inválido");
+  }
+  Node* next = pos.node_->next();
+  detach(pos.prev_, pos.node_, 1);
+  delete_node(pos.node_);
+  return iterator(pos.prev_, next);
+}
+/**
+ * Moves every element of other before pos, in O(1).
+ * \param pos iterator into this list;
+ * \param other list with an equal allocator; left empty.
+ */
+template <typename T, typename Alloc>
+void LinkedList<T, Alloc>::splice(const_iterator pos, LinkedList& other) {
+  if (&other == this || other.empty()) {
+    return;
+  }
+  check_splice(other);
+  Node* first = other.head;
+  Node* last = other.tail;
+  std::size_t count = other.size_;
+  other.detach(nullptr, last, count);
+  attach(pos.prev_, first, last, count);
+}
+/**
+ * Moves the element at it, from other (which may be this list), before
+ * pos, in O(1).
+ * \param pos iterator into this list;
+ * \param other list that holds it;
+ * \param it dereferenceable iterator into other.
+ */
+template <typename T, typename Alloc>
+void LinkedList<T, Alloc>::splice(const_iterator pos, LinkedList& other,
+                                  const_iterator it) {
+  if (&other == this && (it.node_ == pos.node_ || it.node_ == pos.prev_)) {
+    return;
+  }
+  check_splice(other);
+  other.detach(it.prev_, it.node_, 1);
+  attach(pos.prev_, it.node_, it.node_, 1);
+}
+/**
+ * Moves the elements in [first, last), from other (which may be this list,
+ * as long as pos is outside the range), before pos. Within the same list
+ * this is O(1); otherwise the moved elements are counted.
+ * \param pos iterator into this list;
+ * \param other list that holds the range;
+ * \param first first element to move;
+ * \param last element after the last one to move.
+ */
+template <typename T, typename Alloc>
+void LinkedList<T, Alloc>::splice(const_iterator pos, LinkedList& other,
+                                  const_iterator first, const_iterator last) {
+  if (first == last || (&other == this && last.prev_ == pos.prev_)) {
+    return;
+  }
+  check_splice(other);
+  std::size_t count = 0;
+  if (&other != this) {
+    for (const_iterator it = first; it != last; ++it) {
+      count++;
+    }
+  }
+  other.detach(first.prev_, last.prev_, count);
+  attach(pos.prev_, first.node_, last.prev_, count);
+}
+/**
+ * Links a node right after prev.
+ * \return iterator to the new node.
+ */
+template <typename T, typename Alloc>
+typename LinkedList<T, Alloc>::iterator LinkedList<T, Alloc>::link_after(
+    Node* prev, Node* node) {
+  attach(prev, node, node, 1);
+  return iterator(prev, node);
+}
+/**
+ * Links the chain first..last (already linked among themselves) after prev,
+ * or at the front when prev is nullptr.
+ * \param count number of nodes in the chain, added to size().
+ */
+template <typename T, typename Alloc>
+void LinkedList<T, Alloc>::attach(Node* prev, Node* first, Node* last,
+                                  std::size_t count) {
+  if (prev == nullptr) {
+    last->next(head);
+    head = first;
+  } else {
+    last->next(prev->next());
+    prev->next(first);
+  }
+  if (last->next() == nullptr) {
+    tail = last;
+  }
+  size_ += count;
+}
+/**
+ * Unlinks the chain that starts after prev (at head when prev is nullptr)
+ * and ends at last, without freeing it.
+ * \param count number of nodes in the chain, taken from size().
+ */
+template <typename T, typename Alloc>
+void LinkedList<T, Alloc>::detach(Node* prev, Node* last, std::size_t count) {
+  if (prev == nullptr) {
+    head = last->next();
+  } else {
+    prev->next(last->next());
+  }
+  if (last == tail) {
+    tail = prev;
+  }
+  size_ -= count;
+}
+/**
+ * Sorts the list in ascending order (operator<).
+ */
+template <typename T, typename Alloc>
+void LinkedList<T, Alloc>::sort() {
+  sort([](const T& a, const T& b) { return a < b; });
+}
+/**
+ * Sorts the list with a bottom-up merge sort that only relinks nodes: it is
+ * stable, allocates nothing and uses O(1) extra space, in O(n log n).
+ * \param comp strict weak ordering, comp(a, b) true when a goes before b.
+ */
+template <typename T, typename Alloc>
+template <typename Compare>
+void LinkedList<T, Alloc>::sort(Compare comp) {
+  if (size_ < 2) {
+    return;
+  }
+  Node* list = head;
+  Node* last = nullptr;
+  for (std::size_t width = 1; width < size_; width *= 2) {
+    Node* left = list;
+    list = nullptr;
+    last = nullptr;
+    while (left != nullptr) {
+      // Merges the runs of up to width nodes at left and right.
+      Node* right = left;
+      std::size_t left_size = 0;
+      while (right != nullptr && left_size < width) {
+        right = right->next();
+        left_size++;
+      }
+      std::size_t right_size = width;
+      while (left_size > 0 || (right_size > 0 && right != nullptr)) {
+        Node* e;
+        if (left_size == 0) {
+          e = right;
+          right = right->next();
+          right_size--;
+        } else if (right_size == 0 || right == nullptr ||
+                   !comp(right->data(), left->data())) {
+          e = left;
+          left = left->next();
+          left_size--;
+        } else {
+          e = right;
+          right = right->next();
+          right_size--;
+        }
+        if (last == nullptr) {
+          list = e;
+        } else {
+          last->next(e);
+        }
+        last = e;
+      }
+      left = right;
+    }
+    last->next(nullptr);
+  }
+  head = list;
+  tail = last;
+}
+/**
+ * Merges other, sorted in ascending order (operator<), into this sorted
+ * list.
+ */
+template <typename T, typename Alloc>
+void LinkedList<T, Alloc>::merge(LinkedList& other) {
+  merge(other, [](const T& a, const T& b) { return a < b; });
+}
+/**
+ * Merges other into this list in linear time by relinking nodes. Both
+ * must be sorted by comp; equal elements of this list stay before those of
+ * other. other is left empty.
+ * \param other list with an equal allocator;
+ * \param comp ordering both lists are sorted by.
+ */
+template <typename T, typename Alloc>
+template <typename Compare>
+void LinkedList<T, Alloc>::merge(LinkedList& other, Compare comp) {
+  if (&other == this || other.empty()) {
+    return;
+  }
+  check_splice(other);
+  Node* a = head;
+  Node* b = other.head;
+  Node* list = nullptr;
+  Node* last = nullptr;
+  while (a != nullptr && b != nullptr) {
+    Node* e;
+    if (comp(b->data(), a->data())) {
+      e = b;
+      b = b->next();
+    } else {
+      e = a;
+      a = a->next();
+    }
+    if (last == nullptr) {
+      list = e;
+    } else {
+      last->next(e);
+    }
+    last = e;
+  }
+  Node* rest = a != nullptr ? a : b;
+  if (last == nullptr) {
+    list = rest;
+  } else {
+    last->next(rest);
+  }
+  if (b != nullptr) {
+    tail = other.tail;
+  }
+  head = list;
+  size_ += other.size_;
+  other.head = nullptr;
+  other.tail = nullptr;
+  other.size_ = 0;
+}
+/**
+ * Nodes can only move between lists whose allocators can free each
+ * other's nodes.
+ */
+template <typename T, typename Alloc>
+void LinkedList<T, Alloc>::check_splice(const LinkedList& other) const {
+  if (node_alloc_ != other.node_alloc_) {
+    throw std::invalid_argument("Alocadores diferentes");
+  }
+}
 }  // namespace structures
 #endif
@@ -0,0 +1,584 @@
+// Copyright 2017 Eduardo Kohler
+
+#ifndef STRUCTURES_SKIP_LIST_H
+#define STRUCTURES_SKIP_LIST_H
+
+#include <cstddef>    // std::ptrdiff_t
+#include <cstdint>    // std::size_t, std::uint32_t
+#include <iterator>   // std::forward_iterator_tag
+#include <new>        // ::operator new
+#include <stdexcept>  // C++ Exceptions
+#include <utility>    // std::forward, std::move, std::swap
+
+namespace structures {
+/**
+ * Implementation of a template sorted list over a skip list.
+ *
+ * Same vocabulary as a LinkedList kept with insert_sorted, but every node
+ * also takes part in a random number of express levels: a node reaches
+ * level l + 1 with probability 1/4, so insert_sorted, find, contains,
+ * remove and at are expected O(log n). Each link stores how many positions
+ * it skips, which is what lets find and at work with indexes.
+ *
+ * A node is a single allocation: the links of its tower follow the data
+ * inline. Elements are only reachable through const references, since
+ * changing one in place could break the ordering (operator<).
+ */
+template <typename T>
+class SkipList {
+ public:
+  class const_iterator;
+  using iterator = const_iterator;
+
+  static const std::size_t MAX_HEIGHT = 16;  // enough for 4^16 elements
+
+  SkipList();
+  SkipList(const SkipList& other);
+  SkipList(SkipList&& other);
+  SkipList& operator=(const SkipList& other);
+  SkipList& operator=(SkipList&& other);
+  ~SkipList();
+  void clear();
+  void swap(SkipList& other);
+  void insert_sorted(const T& data);
+  void insert_sorted(T&& data);
+  template <typename... Args>
+  void emplace_sorted(Args&&... args);
+  const T& at(std::size_t index) const;
+  const T& front() const;
+  const T& back() const;
+  T pop(std::size_t index);
+  T pop_back();
+  T pop_front();
+  void remove(const T& data);
+  bool empty() const;
+  bool contains(const T& data) const;
+  std::size_t find(const T& data) const;
+  std::size_t size() const;
+
+  const_iterator begin() const;
+  const_iterator cbegin() const;
+  const_iterator end() const;
+  const_iterator cend() const;
+
+ private:
+  class Node;
+
+  /**
+   * One level of a tower: the next node at that level and how many
+   * positions away it is. A null next stands for position size() + 1.
+   */
+  struct Link {
+    Node* next;
+    std::size_t width;
+  };
+
+  class Node {
+   public:
+    template <typename... Args>
+    static Node* create(std::size_t height, Args&&... args) {
+      static_assert(alignof(Node) % alignof(Link) == 0,
+                    "the tower must be aligned right after the node");
+      void* memory = ::operator new(sizeof(Node) + height * sizeof(Link));
+      try {
+        return new (memory) Node(height, std::forward<Args>(args)...);
+      } catch (...) {
+        ::operator delete(memory);
+        throw;
+      }
+    }
+
+    // The node is bigger than sizeof(Node): never pass the size along.
+    static void operator delete(void* pointer) { ::operator delete(pointer); }
+
+    T& data() { return data_; }
+
+    const T& data() const { return data_; }
+
+    std::size_t height() const { return height_; }
+
+    /**
+     * The tower: height links stored right after the node.
+     */
+    Link* links() { return reinterpret_cast<Link*>(this + 1); }
+
+    const Link* links() const {
+      return reinterpret_cast<const Link*>(this + 1);
+    }
+
+   private:
+    template <typename... Args>
+    explicit Node(std::size_t height, Args&&... args)
+        : data_(std::forward<Args>(args)...), height_{height} {
+      for (std::size_t level = 0; level < height; level++) {
+        new (&links()[level]) Link{nullptr, 0};
+      }
+    }
+
+    T data_;
+    std::size_t height_;
+  };
+
+  std::size_t random_height();
+  void search(const T& data, Link** update);
+  void locate(std::size_t position, Link** update);
+  void link(Node* node);
+  void unlink(Node* node, Link** update);
+  const Node* node_at(std::size_t index) const;
+
+  Link head_[MAX_HEIGHT];  // links before the first element
+  std::size_t height_{1};  // levels in use
+  std::size_t size_{0u};
+  std::uint32_t seed_{2463534242u};
+};
+/**
+ * Forward iterator over a SkipList, in ascending order.
+ */
+template <typename T>
+class SkipList<T>::const_iterator {
+ public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = T;
+  using difference_type = std::ptrdiff_t;
+  using pointer = const T*;
+  using reference = const T&;
+
+  const_iterator() = default;
+
+  reference operator*() const { return node_->data(); }
+
+  pointer operator->() const { return &node_->data(); }
+
+  const_iterator& operator++() {
+    node_ = node_->links()[0].next;
+    return *this;
+  }
+
+  const_iterator operator++(int) {
+    const_iterator old = *this;
+    ++*this;
+    return old;
+  }
+
+  bool operator==(const const_iterator& other) const {
+    return node_ == other.node_;
+  }
+
+  bool operator!=(const const_iterator& other) const {
+    return node_ != other.node_;
+  }
+
+ private:
+  friend class SkipList;
+
+  explicit const_iterator(const Node* node) : node_{node} {}
+
+  const Node* node_{nullptr};
+};
+/**
+ * Constructor. Sets the attributes values.
+ */
+template <typename T>
+SkipList<T>::SkipList() {
+  head_[0] = Link{nullptr, 1};
+}
+/**
+ * Copy constructor. Copies every element of other, keeping the shape of
+ * its towers, in O(n).
+ */
+template <typename T>
+SkipList<T>::SkipList(const SkipList& other) : SkipList() {
+  Link* last[MAX_HEIGHT];
+  std::size_t rank[MAX_HEIGHT];
+  for (std::size_t level = 0; level < MAX_HEIGHT; level++) {
+    head_[level] = Link{nullptr, 0};
+    last[level] = head_;
+    rank[level] = 0;
+  }
+  height_ = other.height_;
+  seed_ = other.seed_;
+  for (const Node* it = other.head_[0].next; it != nullptr;
+       it = it->links()[0].next) {
+    Node* input = Node::create(it->height(), it->data());
+    size_++;
+    for (std::size_t level = 0; level < input->height(); level++) {
+      last[level][level] = Link{input, size_ - rank[level]};
+      last[level] = input->links();
+      rank[level] = size_;
+    }
+  }
+  for (std::size_t level = 0; level < height_; level++) {
+    last[level][level].width = size_ + 1 - rank[level];
+  }
+}
+/**
+ * Move constructor. Takes the nodes of other, leaving it empty.
+ */
+template <typename T>
+SkipList<T>::SkipList(SkipList&& other)
+    : height_{other.height_}, size_{other.size_}, seed_{other.seed_} {
+  for (std::size_t level = 0; level < height_; level++) {
+    head_[level] = other.head_[level];
+  }
+  other.head_[0] = Link{nullptr, 1};
+  other.height_ = 1;
+  other.size_ = 0;
+}
+/**
+ * Copy assignment.
+ */
+template <typename T>
+SkipList<T>& SkipList<T>::operator=(const SkipList& other) {
+  SkipList copy(other);
+  swap(copy);
+  return *this;
+}
+/**
+ * Move assignment. The previous elements are destroyed.
+ */
+template <typename T>
+SkipList<T>& SkipList<T>::operator=(SkipList&& other) {
+  SkipList moved(std::move(other));
+  swap(moved);
+  return *this;
+}
+/**
+ * Destructor. Deletes every node.
+ */
+template <typename T>
+SkipList<T>::~SkipList() {
+  clear();
+}
+/**
+ * Clears the list.
+ */
+template <typename T>
+void SkipList<T>::clear() {
+  Node* current = head_[0].next;
+  while (current != nullptr) {
+    Node* next = current->links()[0].next;
+    delete current;
+    current = next;
+  }
+  head_[0] = Link{nullptr, 1};
+  height_ = 1;
+  size_ = 0;
+}
+/**
+ * Exchanges the contents of two lists. Only the head towers are copied.
+ */
+template <typename T>
+void SkipList<T>::swap(SkipList& other) {
+  std::size_t height = height_ > other.height_ ? height_ : other.height_;
+  for (std::size_t level = 0; level < height; level++) {
+    std::swap(head_[level], other.head_[level]);
+  }
+  std::swap(height_, other.height_);
+  std::swap(size_, other.size_);
+  std::swap(seed_, other.seed_);
+}
+/**
+ * Inserts an element before any equal ones, keeping the list sorted.
+ * \param data data reference.
+ */
+template <typename T>
+void SkipList<T>::insert_sorted(const T& data) {
+  link(Node::create(random_height(), data));
+}
+/**
+ * Inserts an element before any equal ones, moving it in.
+ * \param data data to be moved.
+ */
+template <typename T>
+void SkipList<T>::insert_sorted(T&& data) {
+  link(Node::create(random_height(), std::move(data)));
+}
+/**
+ * Builds an element from constructor arguments and inserts it in order.
+ */
+template <typename T>
+template <typename... Args>
+void SkipList<T>::emplace_sorted(Args&&... args) {
+  link(Node::create(random_height(), std::forward<Args>(args)...));
+}
+/**
+ * Returns a reference to the element at the specified index.
+ */
+template <typename T>
+const T& SkipList<T>::at(std::size_t index) const {
+  if (index >= size()) {
+    throw std::out_of_range("Index inválido");
+  }
+  return node_at(index)->data();
+}
+/**
+ * Returns a reference to the first (smallest) element.
+ */
+template <typename T>
+const T& SkipList<T>::front() const {
+  if (empty()) {
+    throw std::out_of_range("Lista vazia");
+  }
+  return head_[0].next->data();
+}
+/**
+ * Returns a reference to the last (greatest) element.
+ */
+template <typename T>
+const T& SkipList<T>::back() const {
+  if (empty()) {
+    throw std::out_of_range("Lista vazia");
+  }
+  return node_at(size_ - 1)->data();
+}
+/**
+ * Takes an element out by its index.
+ * \param index element index.
+ */
+template <typename T>
+T SkipList<T>::pop(std::size_t index) {
+  if (empty()) {
+    throw std::out_of_range("Lista vazia");
+  }
+  if (index >= size()) {
+    throw std::out_of_range("Index inválido");
+  }
+  Link* update[MAX_HEIGHT];
+  locate(index + 1, update);
+  Node* popped = update[0][0].next;
+  unlink(popped, update);
+  T output_ = std::move(popped->data());
+  delete popped;
+  return output_;
+}
+/**
+ * Removes the last element.
+ */
+template <typename T>
+T SkipList<T>::pop_back() {
+  if (empty()) {
+    throw std::out_of_range("Lista vazia");
+  }
+  return pop(size_ - 1);
+}
+/**
+ * Removes the first element.
+ */
+template <typename T>
+T SkipList<T>::pop_front() {
+  return pop(0);
+}
+/**
+ * Removes the first element equal to data, if there is one.
+ * \param data data.
+ */
+template <typename T>
+void SkipList<T>::remove(const T& data) {
+  Link* update[MAX_HEIGHT];
+  search(data, update);
+  Node* found = update[0][0].next;
+  if (found != nullptr && !(data < found->data())) {
+    unlink(found, update);
+    delete found;
+  }
+}
+/**
+ * Checks if the list is empty.
+ * \return boolean
+ */
+template <typename T>
+bool SkipList<T>::empty() const {
+  return size_ == 0;
+}
+/**
+ * Checks if the list contains a certain element by its content.
+ * \return boolean
+ */
+template <typename T>
+bool SkipList<T>::contains(const T& data) const {
+  return find(data) != size();
+}
+/**
+ * Returns the index of the first element equal to data, or size() if there
+ * is none.
+ * \return specified element index.
+ */
+template <typename T>
+std::size_t SkipList<T>::find(const T& data) const {
+  const Link* links = head_;
+  std::size_t position = 0;
+  for (std::size_t level = height_; level-- > 0;) {
+    while (links[level].next != nullptr &&
+           links[level].next->data() < data) {
+      position += links[level].width;
+      links = links[level].next->links();
+    }
+  }
+  const Node* found = links[0].next;
+  if (found != nullptr && !(data < found->data())) {
+    return position;
+  }
+  return size();
+}
+/**
+ * Returns the list current size.
+ */
+template <typename T>
+std::size_t SkipList<T>::size() const {
+  return size_;
+}
+/**
+ * Returns an iterator to the first element.
+ */
+template <typename T>
+typename SkipList<T>::const_iterator SkipList<T>::begin() const {
+  return const_iterator(head_[0].next);
+}
+/**
+ * Returns an iterator to the first element.
+ */
+template <typename T>
+typename SkipList<T>::const_iterator SkipList<T>::cbegin() const {
+  return begin();
+}
+/**
+ * Returns the past-the-end iterator.
+ */
+template <typename T>
+typename SkipList<T>::const_iterator SkipList<T>::end() const {
+  return const_iterator(nullptr);
+}
+/**
+ * Returns the past-the-end iterator.
+ */
+template <typename T>
+typename SkipList<T>::const_iterator SkipList<T>::cend() const {
+  return end();
+}
+/**
+ * Draws a tower height: each extra level has probability 1/4 (xorshift).
+ */
+template <typename T>
+std::size_t SkipList<T>::random_height() {
+  seed_ ^= seed_ << 13;
+  seed_ ^= seed_ >> 17;
+  seed_ ^= seed_ << 5;
+  std::uint32_t bits = seed_;
+  std::size_t height = 1;
+  while (height < MAX_HEIGHT && (bits & 3u) == 0) {
+    height++;
+    bits >>= 2;
+  }
+  return height;
+}
+/**
+ * Fills update with, for every level in use, the tower whose link at that
+ * level is the last one before the first element not less than data.
+ */
+template <typename T>
+void SkipList<T>::search(const T& data, Link** update) {
+  Link* links = head_;
+  for (std::size_t level = height_; level-- > 0;) {
+    while (links[level].next != nullptr &&
+           links[level].next->data() < data) {
+      links = links[level].next->links();
+    }
+    update[level] = links;
+  }
+}
+/**
+ * Same as search, for the element at position (index + 1).
+ */
+template <typename T>
+void SkipList<T>::locate(std::size_t position, Link** update) {
+  Link* links = head_;
+  std::size_t rank = 0;
+  for (std::size_t level = height_; level-- > 0;) {
+    while (links[level].next != nullptr &&
+           rank + links[level].width < position) {
+      rank += links[level].width;
+      links = links[level].next->links();
+    }
+    update[level] = links;
+  }
+}
+/**
+ * Links a new node before the first element not less than its data.
+ * Positions are counted from the head, at 0.
+ */
+template <typename T>
+void SkipList<T>::link(Node* node) {
+  std::size_t height = node->height();
+  for (; height_ < height; height_++) {
+    head_[height_] = Link{nullptr, size_ + 1};
+  }
+  Link* update[MAX_HEIGHT];
+  std::size_t rank[MAX_HEIGHT];
+  Link* links = head_;
+  std::size_t position = 0;
+  for (std::size_t level = height_; level-- > 0;) {
+    while (links[level].next != nullptr &&
+           links[level].next->data() < node->data()) {
+      position += links[level].width;
+      links = links[level].next->links();
+    }
+    update[level] = links;
+    rank[level] = position;
+  }
+  position++;
+  Link* tower = node->links();
+  for (std::size_t level = 0; level < height; level++) {
+    Link& before = update[level][level];
+    tower[level] = Link{before.next, before.width + rank[level] + 1 - position};
+    before = Link{node, position - rank[level]};
+  }
+  for (std::size_t level = height; level < height_; level++) {
+    update[level][level].width++;
+  }
+  size_++;
+}
+/**
+ * Unlinks node, given the towers found by search or locate. Levels left
+ * empty at the top stop being used.
+ */
+template <typename T>
+void SkipList<T>::unlink(Node* node, Link** update) {
+  Link* tower = node->links();
+  for (std::size_t level = 0; level < node->height(); level++) {
+    Link& before = update[level][level];
+    before = Link{tower[level].next, before.width + tower[level].width - 1};
+  }
+  for (std::size_t level = node->height(); level < height_; level++) {
+    update[level][level].width--;
+  }
+  while (height_ > 1 && head_[height_ - 1].next == nullptr) {
+    height_--;
+  }
+  size_--;
+}
+/**
+ * Walks down the towers to the node at index (which must be valid).
+ */
+template <typename T>
+const typename SkipList<T>::Node* SkipList<T>::node_at(
+    std::size_t index) const {
+  const Link* links = head_;
+  const Node* current = nullptr;
+  std::size_t rank = 0;
+  std::size_t position = index + 1;
+  for (std::size_t level = height_; level-- > 0;) {
+    while (links[level].next != nullptr &&
+           rank + links[level].width <= position) {
+      rank += links[level].width;
+      current = links[level].next;
+      links = current->links();
+    }
+    if (rank == position) {
+      break;
+    }
+  }
+  return current;
+}
+}  // namespace structures
+
+#endif
@@ -0,0 +1,782 @@
+// Copyright 2017 Eduardo Kohler
+
+#ifndef STRUCTURES_UNROLLED_LINKED_LIST_H
+#define STRUCTURES_UNROLLED_LINKED_LIST_H
+
+#include <cstddef>      // std::ptrdiff_t
+#include <cstdint>      // std::size_t
+#include <iterator>     // std::forward_iterator_tag
+#include <memory>       // std::allocator, std::allocator_traits
+#include <new>          // placement new
+#include <stdexcept>    // C++ Exceptions
+#include <type_traits>  // std::aligned_storage, std::conditional
+#include <utility>      // std::forward, std::move, std::swap
+
+#include "../lista/simd_find.h"
+#include "../memoria/node_pool.h"
+
+namespace structures {
+/**
+ * Implementation of a template unrolled linked list.
+ *
+ * Same interface as LinkedList, but each node holds up to K elements in a
+ * small array, so a walk touches one node (and one allocation) per K
+ * elements and find scans contiguous memory with simd::find. The default K
+ * makes the array about 112 bytes, two cache lines with the node header.
+ *
+ * A full node is split in two halves before an insertion; a node left
+ * below half occupancy by a pop takes elements from the next one, or is
+ * merged with it when both fit in a single node. Appending to a full tail
+ * (and prepending to a full head) starts a new node instead, so filling
+ * the list from either end leaves the nodes full.
+ */
+template <typename T, std::size_t K = (sizeof(T) < 16 ? 112 / sizeof(T) : 8),
+          typename Alloc = std::allocator<T>>
+class UnrolledLinkedList {
+  static_assert(K >= 2, "Nodes must hold at least two elements");
+
+ public:
+  template <bool Const>
+  class Iterator;
+  using iterator = Iterator<false>;
+  using const_iterator = Iterator<true>;
+
+  UnrolledLinkedList();
+  UnrolledLinkedList(const UnrolledLinkedList& other);
+  UnrolledLinkedList(UnrolledLinkedList&& other);
+  UnrolledLinkedList& operator=(const UnrolledLinkedList& other);
+  UnrolledLinkedList& operator=(UnrolledLinkedList&& other);
+  ~UnrolledLinkedList();
+  void clear();
+  void swap(UnrolledLinkedList& other);
+  void push_back(const T& data);
+  void push_back(T&& data);
+  void push_front(const T& data);
+  void push_front(T&& data);
+  template <typename... Args>
+  void emplace_back(Args&&... args);
+  template <typename... Args>
+  void emplace_front(Args&&... args);
+  void insert(const T& data, std::size_t index);
+  void insert(T&& data, std::size_t index);
+  void insert_sorted(const T& data);
+  T& at(std::size_t index);
+  const T& at(std::size_t index) const;
+  T& back();
+  const T& back() const;
+  T pop(std::size_t index);
+  T pop_back();
+  T pop_front();
+  void remove(const T& data);
+  bool empty() const;
+  bool contains(const T& data) const;
+  std::size_t find(const T& data) const;
+  std::size_t size() const;
+
+  iterator begin();
+  const_iterator begin() const;
+  const_iterator cbegin() const;
+  iterator end();
+  const_iterator end() const;
+  const_iterator cend() const;
+
+ private:
+  class Node {
+   public:
+    Node() = default;
+
+    Node(const Node&) = delete;
+
+    Node& operator=(const Node&) = delete;
+
+    ~Node() {
+      for (std::size_t i = 0; i < count_; i++) {
+        at(i).~T();
+      }
+    }
+
+    T& at(std::size_t index) {
+      return *reinterpret_cast<T*>(&slots_[index]);
+    }
+
+    const T& at(std::size_t index) const {
+      return *reinterpret_cast<const T*>(&slots_[index]);
+    }
+
+    const T* data() const { return reinterpret_cast<const T*>(slots_); }
+
+    std::size_t count() const { return count_; }
+
+    bool full() const { return count_ == K; }
+
+    Node* next() { return next_; }
+
+    const Node* next() const { return next_; }
+
+    void next(Node* node) { next_ = node; }
+
+    /**
+     * Builds an element at index, shifting the ones after it. The node
+     * must not be full.
+     */
+    template <typename... Args>
+    void emplace(std::size_t index, Args&&... args) {
+      if (index == count_) {
+        new (&slots_[count_]) T(std::forward<Args>(args)...);
+      } else {
+        T input(std::forward<Args>(args)...);
+        new (&slots_[count_]) T(std::move(at(count_ - 1)));
+        for (std::size_t i = count_ - 1; i > index; i--) {
+          at(i) = std::move(at(i - 1));
+        }
+        at(index) = std::move(input);
+      }
+      count_++;
+    }
+
+    /**
+     * Moves the element at index out, shifting the ones after it.
+     */
+    T take(std::size_t index) {
+      T output(std::move(at(index)));
+      for (std::size_t i = index + 1; i < count_; i++) {
+        at(i - 1) = std::move(at(i));
+      }
+      at(--count_).~T();
+      return output;
+    }
+
+    /**
+     * Moves the elements from index on to the end of other.
+     */
+    void move_to(Node* other, std::size_t index) {
+      for (std::size_t i = index; i < count_; i++) {
+        new (&other->slots_[other->count_]) T(std::move(at(i)));
+        other->count_++;
+        at(i).~T();
+      }
+      count_ = index;
+    }
+
+   private:
+    using Slot =
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type;
+
+    Node* next_{nullptr};
+    std::size_t count_{0};
+    Slot slots_[K];
+  };
+
+  using NodeAlloc =
+      typename std::allocator_traits<Alloc>::template rebind_alloc<Node>;
+  using NodeTraits = std::allocator_traits<NodeAlloc>;
+
+  Node* new_node() {
+    Node* node = NodeTraits::allocate(node_alloc_, 1);
+    try {
+      NodeTraits::construct(node_alloc_, node);
+    } catch (...) {
+      NodeTraits::deallocate(node_alloc_, node, 1);
+      throw;
+    }
+    return node;
+  }
+
+  void delete_node(Node* node) {
+    NodeTraits::destroy(node_alloc_, node);
+    NodeTraits::deallocate(node_alloc_, node, 1);
+  }
+
+  template <typename... Args>
+  void emplace_at(std::size_t index, Args&&... args);
+  template <typename... Args>
+  void emplace_alone(Node* prev, Args&&... args);
+  template <typename... Args>
+  void emplace_in(Node* node, std::size_t offset, Args&&... args);
+  T take(Node* prev, Node* node, std::size_t offset);
+  void unlink(Node* prev, Node* node);
+  const Node* node_at(std::size_t* index) const;
+
+  Node* head{nullptr};
+  Node* tail{nullptr};
+  std::size_t size_{0u};
+  NodeAlloc node_alloc_;
+};
+/**
+ * Forward iterator over an UnrolledLinkedList: a node and a position in
+ * its array.
+ */
+template <typename T, std::size_t K, typename Alloc>
+template <bool Const>
+class UnrolledLinkedList<T, K, Alloc>::Iterator {
+ public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = T;
+  using difference_type = std::ptrdiff_t;
+  using pointer = typename std::conditional<Const, const T*, T*>::type;
+  using reference = typename std::conditional<Const, const T&, T&>::type;
+
+  Iterator() = default;
+
+  template <bool C, typename = typename std::enable_if<Const && !C>::type>
+  Iterator(const Iterator<C>& other)  // NOLINT(runtime/explicit)
+      : node_{other.node_}, offset_{other.offset_} {}
+
+  reference operator*() const { return node_->at(offset_); }
+
+  pointer operator->() const { return &node_->at(offset_); }
+
+  Iterator& operator++() {
+    if (++offset_ == node_->count()) {
+      node_ = node_->next();
+      offset_ = 0;
+    }
+    return *this;
+  }
+
+  Iterator operator++(int) {
+    Iterator old = *this;
+    ++*this;
+    return old;
+  }
+
+  bool operator==(const Iterator& other) const {
+    return node_ == other.node_ && offset_ == other.offset_;
+  }
+
+  bool operator!=(const Iterator& other) const { return !(*this == other); }
+
+ private:
+  friend class UnrolledLinkedList;
+  friend class Iterator<!Const>;
+
+  using NodePointer =
+      typename std::conditional<Const, const Node*, Node*>::type;
+
+  Iterator(NodePointer node, std::size_t offset)
+      : node_{node}, offset_{offset} {}
+
+  NodePointer node_{nullptr};
+  std::size_t offset_{0};
+};
+/**
+ * Constructor. Sets the attributes values.
+ */
+template <typename T, std::size_t K, typename Alloc>
+UnrolledLinkedList<T, K, Alloc>::UnrolledLinkedList() {}
+/**
+ * Copy constructor. Copies every node of other, with the same occupancy.
+ */
+template <typename T, std::size_t K, typename Alloc>
+UnrolledLinkedList<T, K, Alloc>::UnrolledLinkedList(
+    const UnrolledLinkedList& other)
+    : node_alloc_{NodeTraits::select_on_container_copy_construction(
+          other.node_alloc_)} {
+  try {
+    for (const Node* it = other.head; it != nullptr; it = it->next()) {
+      Node* input = new_node();
+      if (tail == nullptr) {
+        head = input;
+      } else {
+        tail->next(input);
+      }
+      tail = input;
+      for (std::size_t i = 0; i < it->count(); i++) {
+        input->emplace(i, it->at(i));
+        size_++;
+      }
+    }
+  } catch (...) {
+    clear();
+    throw;
+  }
+}
+/**
+ * Move constructor. Takes the nodes of other, leaving it empty.
+ */
+template <typename T, std::size_t K, typename Alloc>
+UnrolledLinkedList<T, K, Alloc>::UnrolledLinkedList(
+    UnrolledLinkedList&& other)
+    : head{other.head},
+      tail{other.tail},
+      size_{other.size_},
+      node_alloc_{other.node_alloc_} {
+  other.head = nullptr;
+  other.tail = nullptr;
+  other.size_ = 0;
+}
+/**
+ * Copy assignment.
+ */
+template <typename T, std::size_t K, typename Alloc>
+UnrolledLinkedList<T, K, Alloc>& UnrolledLinkedList<T, K, Alloc>::operator=(
+    const UnrolledLinkedList& other) {
+  UnrolledLinkedList copy(other);
+  swap(copy);
+  return *this;
+}
+/**
+ * Move assignment. The previous elements are destroyed.
+ */
+template <typename T, std::size_t K, typename Alloc>
+UnrolledLinkedList<T, K, Alloc>& UnrolledLinkedList<T, K, Alloc>::operator=(
+    UnrolledLinkedList&& other) {
+  UnrolledLinkedList moved(std::move(other));
+  swap(moved);
+  return *this;
+}
+/**
+ * Destructor. Deletes every node.
+ */
+template <typename T, std::size_t K, typename Alloc>
+UnrolledLinkedList<T, K, Alloc>::~UnrolledLinkedList() {
+  clear();
+}
+/**
+ * Clears the list. With a PoolAllocator the whole pool is released at
+ * once, and nodes of trivially destructible elements are not even walked.
+ */
+template <typename T, std::size_t K, typename Alloc>
+void UnrolledLinkedList<T, K, Alloc>::clear() {
+  bool bulk = BulkRelease<NodeAlloc>::available(node_alloc_);
+  if (!bulk || !std::is_trivially_destructible<T>::value) {
+    Node* current = head;
+    while (current != nullptr) {
+      Node* next = current->next();
+      if (bulk) {
+        NodeTraits::destroy(node_alloc_, current);
+      } else {
+        delete_node(current);
+      }
+      current = next;
+    }
+  }
+  if (bulk) {
+    BulkRelease<NodeAlloc>::release(node_alloc_);
+  }
+  head = nullptr;
+  tail = nullptr;
+  size_ = 0;
+}
+/**
+ * Exchanges the contents of two lists in O(1).
+ */
+template <typename T, std::size_t K, typename Alloc>
+void UnrolledLinkedList<T, K, Alloc>::swap(UnrolledLinkedList& other) {
+  std::swap(head, other.head);
+  std::swap(tail, other.tail);
+  std::swap(size_, other.size_);
+  std::swap(node_alloc_, other.node_alloc_);
+}
+/**
+ * Adds an element to the end of the list.
+ */
+template <typename T, std::size_t K, typename Alloc>
+void UnrolledLinkedList<T, K, Alloc>::push_back(const T& data) {
+  emplace_at(size_, data);
+}
+/**
+ * Adds an element to the end of the list, moving it in.
+ */
+template <typename T, std::size_t K, typename Alloc>
+void UnrolledLinkedList<T, K, Alloc>::push_back(T&& data) {
+  emplace_at(size_, std::move(data));
+}
+/**
+ * Adds an element to the front of the list.
+ */
+template <typename T, std::size_t K, typename Alloc>
+void UnrolledLinkedList<T, K, Alloc>::push_front(const T& data) {
+  emplace_at(0, data);
+}
+/**
+ * Adds an element to the front of the list, moving it in.
+ */
+template <typename T, std::size_t K, typename Alloc>
+void UnrolledLinkedList<T, K, Alloc>::push_front(T&& data) {
+  emplace_at(0, std::move(data));
+}
+/**
+ * Builds an element at the end of the list from constructor arguments.
+ */
+template <typename T, std::size_t K, typename Alloc>
+template <typename... Args>
+void UnrolledLinkedList<T, K, Alloc>::emplace_back(Args&&... args) {
+  emplace_at(size_, std::forward<Args>(args)...);
+}
+/**
+ * Builds an element at the front of the list from constructor arguments.
+ */
+template <typename T, std::size_t K, typename Alloc>
+template <typename... Args>
+void UnrolledLinkedList<T, K, Alloc>::emplace_front(Args&&... args) {
+  emplace_at(0, std::forward<Args>(args)...);
+}
+/**
+ * Inserts an element in the specified location.
+ * \param data data reference;
+ * \param index index where the element will be put in.
+ */
+template <typename T, std::size_t K, typename Alloc>
+void UnrolledLinkedList<T, K, Alloc>::insert(const T& data,
+                                             std::size_t index) {
+  emplace_at(index, data);
+}
+/**
+ * Inserts an element in the specified location, moving it in.
+ * \param data data to be moved;
+ * \param index index where the element will be put in.
+ */
+template <typename T, std::size_t K, typename Alloc>
+void UnrolledLinkedList<T, K, Alloc>::insert(T&& data, std::size_t index) {
+  emplace_at(index, std::move(data));
+}
+/**
+ * Inserts an element respecting a specific progression. Whole nodes are
+ * skipped by looking at their last element only.
+ * \param data data.
+ */
+template <typename T, std::size_t K, typename Alloc>
+void UnrolledLinkedList<T, K, Alloc>::insert_sorted(const T& data) {
+  Node* current = head;
+  while (current != nullptr && data > current->at(current->count() - 1)) {
+    current = current->next();
+  }
+  if (current == nullptr) {
+    emplace_at(size_, data);
+    return;
+  }
+  std::size_t offset = 0;
+  while (data > current->at(offset)) {
+    offset++;
+  }
+  emplace_in(current, offset, data);
+}
+/**
+ * Returns a reference to the element at the specified index.
+ */
+template <typename T, std::size_t K, typename Alloc>
+T& UnrolledLinkedList<T, K, Alloc>::at(std::size_t index) {
+  if (index >= size()) {
+    throw std::out_of_range("Index inválido");
+  }
+  Node* current = const_cast<Node*>(node_at(&index));
+  return current->at(index);
+}
+/**
+ * Returns a reference to the element at the specified index.
+ */
+template <typename T, std::size_t K, typename Alloc>
+const T& UnrolledLinkedList<T, K, Alloc>::at(std::size_t index) const {
+  if (index >= size()) {
+    throw std::out_of_range("Index inválido");
+  }
+  return node_at(&index)->at(index);
+}
+/**
+ * Returns a reference to the last element.
+ */
+template <typename T, std::size_t K, typename Alloc>
+T& UnrolledLinkedList<T, K, Alloc>::back() {
+  if (empty()) {
+    throw std::out_of_range("Lista vazia");
+  }
+  return tail->at(tail->count() - 1);
+}
+/**
+ * Returns a reference to the last element.
+ */
+template <typename T, std::size_t K, typename Alloc>
+const T& UnrolledLinkedList<T, K, Alloc>::back() const {
+  if (empty()) {
+    throw std::out_of_range("Lista vazia");
+  }
+  return tail->at(tail->count() - 1);
+}
+/**
+ * Takes an element out by its index.
+ * \param index element index.
+ */
+template <typename T, std::size_t K, typename Alloc>
+T UnrolledLinkedList<T, K, Alloc>::pop(std::size_t index) {
+  if (empty()) {
+    throw std::out_of_range("Lista vazia");
+  } else if (index > size() - 1) {
+    throw std::out_of_range("Parâmetro inválido");
+  }
+  Node* prev = nullptr;
+  Node* current = head;
+  while (index >= current->count()) {
+    index -= current->count();
+    prev = current;
+    current = current->next();
+  }
+  return take(prev, current, index);
+}
+/**
+ * Removes the last element.
+ */
+template <typename T, std::size_t K, typename Alloc>
+T UnrolledLinkedList<T, K, Alloc>::pop_back() {
+  if (empty()) {
+    throw std::out_of_range("Lista vazia");
+  }
+  return pop(size_ - 1);
+}
+/**
+ * Removes the first element.
+ * \return The first element of type T.
+ */
+template <typename T, std::size_t K, typename Alloc>
+T UnrolledLinkedList<T, K, Alloc>::pop_front() {
+  if (empty()) {
+    throw std::out_of_range("Lista vazia");
+  }
+  return take(nullptr, head, 0);
+}
+/**
+ * Removes the first element equal to data, if there is one.
+ * \param data data.
+ */
+template <typename T, std::size_t K, typename Alloc>
+void UnrolledLinkedList<T, K, Alloc>::remove(const T& data) {
+  Node* prev = nullptr;
+  for (Node* it = head; it != nullptr; it = it->next()) {
+    std::size_t offset = simd::find(it->data(), it->count(), data);
+    if (offset != it->count()) {
+      take(prev, it, offset);
+      return;
+    }
+    prev = it;
+  }
+}
+/**
+ * Checks if the list is empty.
+ * \return boolean
+ */
+template <typename T, std::size_t K, typename Alloc>
+bool UnrolledLinkedList<T, K, Alloc>::empty() const {
+  return size_ == 0;
+}
+/**
+ * Checks if the list contains a certain element by its content.
+ * \return boolean
+ */
+template <typename T, std::size_t K, typename Alloc>
+bool UnrolledLinkedList<T, K, Alloc>::contains(const T& data) const {
+  return find(data) != size();
+}
+/**
+ * Checks if the list has a certain element, and if so, returns its index.
+ * \return specified element index.
+ */
+template <typename T, std::size_t K, typename Alloc>
+std::size_t UnrolledLinkedList<T, K, Alloc>::find(const T& data) const {
+  std::size_t index = 0;
+  for (const Node* it = head; it != nullptr; it = it->next()) {
+    std::size_t offset = simd::find(it->data(), it->count(), data);
+    if (offset != it->count()) {
+      return index + offset;
+    }
+    index += it->count();
+  }
+  return size();
+}
+/**
+ * Returns the list current size.
+ */
+template <typename T, std::size_t K, typename Alloc>
+std::size_t UnrolledLinkedList<T, K, Alloc>::size() const {
+  return size_;
+}
+/**
+ * Returns an iterator to the first element.
+ */
+template <typename T, std::size_t K, typename Alloc>
+typename UnrolledLinkedList<T, K, Alloc>::iterator
+UnrolledLinkedList<T, K, Alloc>::begin() {
+  return iterator(head, 0);
+}
+/**
+ * Returns an iterator to the first element.
+ */
+template <typename T, std::size_t K, typename Alloc>
+typename UnrolledLinkedList<T, K, Alloc>::const_iterator
+UnrolledLinkedList<T, K, Alloc>::begin() const {
+  return const_iterator(head, 0);
+}
+/**
+ * Returns an iterator to the first element.
+ */
+template <typename T, std::size_t K, typename Alloc>
+typename UnrolledLinkedList<T, K, Alloc>::const_iterator
+UnrolledLinkedList<T, K, Alloc>::cbegin() const {
+  return begin();
+}
+/**
+ * Returns the past-the-end iterator.
+ */
+template <typename T, std::size_t K, typename Alloc>
+typename UnrolledLinkedList<T, K, Alloc>::iterator
+UnrolledLinkedList<T, K, Alloc>::end() {
+  return iterator(nullptr, 0);
+}
+/**
+ * Returns the past-the-end iterator.
+ */
+template <typename T, std::size_t K, typename Alloc>
+typename UnrolledLinkedList<T, K, Alloc>::const_iterator
+UnrolledLinkedList<T, K, Alloc>::end() const {
+  return const_iterator(nullptr, 0);
+}
+/**
+ * Returns the past-the-end iterator.
+ */
+template <typename T, std::size_t K, typename Alloc>
+typename UnrolledLinkedList<T, K, Alloc>::const_iterator
+UnrolledLinkedList<T, K, Alloc>::cend() const {
+  return end();
+}
+/**
+ * Builds an element so that it ends up at index. Between two nodes the
+ * earlier one is preferred, which keeps appends at the tail node.
+ * \param index valid position (at most size()).
+ */
+template <typename T, std::size_t K, typename Alloc>
+template <typename... Args>
+void UnrolledLinkedList<T, K, Alloc>::emplace_at(std::size_t index,
+                                                 Args&&... args) {
+  if (index > size()) {
+    throw std::out_of_range("Index inválido");
+  }
+  if (index == 0 && (head == nullptr || head->full())) {
+    emplace_alone(nullptr, std::forward<Args>(args)...);
+  } else if (index == size_ && tail->full()) {
+    emplace_alone(tail, std::forward<Args>(args)...);
+  } else if (index == size_) {
+    emplace_in(tail, tail->count(), std::forward<Args>(args)...);
+  } else {
+    Node* current = head;
+    while (index > current->count()) {
+      index -= current->count();
+      current = current->next();
+    }
+    emplace_in(current, index, std::forward<Args>(args)...);
+  }
+}
+/**
+ * Builds an element in a node of its own, linked after prev (or as the
+ * head, when prev is nullptr).
+ */
+template <typename T, std::size_t K, typename Alloc>
+template <typename... Args>
+void UnrolledLinkedList<T, K, Alloc>::emplace_alone(Node* prev,
+                                                    Args&&... args) {
+  Node* node = new_node();
+  try {
+    node->emplace(0, std::forward<Args>(args)...);
+  } catch (...) {
+    delete_node(node);
+    throw;
+  }
+  if (prev == nullptr) {
+    node->next(head);
+    head = node;
+  } else {
+    node->next(prev->next());
+    prev->next(node);
+  }
+  if (prev == tail) {
+    tail = node;
+  }
+  size_++;
+}
+/**
+ * Builds an element at offset in node, splitting the node first if it is
+ * full.
+ */
+template <typename T, std::size_t K, typename Alloc>
+template <typename... Args>
+void UnrolledLinkedList<T, K, Alloc>::emplace_in(Node* node,
+                                                 std::size_t offset,
+                                                 Args&&... args) {
+  if (node->full()) {
+    // Built before the split, since args may refer to an element it moves.
+    T value(std::forward<Args>(args)...);
+    Node* upper = new_node();
+    node->move_to(upper, K / 2);
+    upper->next(node->next());
+    node->next(upper);
+    if (tail == node) {
+      tail = upper;
+    }
+    if (offset > node->count()) {
+      offset -= node->count();
+      node = upper;
+    }
+    node->emplace(offset, std::move(value));
+  } else {
+    node->emplace(offset, std::forward<Args>(args)...);
+  }
+  size_++;
+}
+/**
+ * Moves the element at offset in node out. A node left below half
+ * occupancy takes an element from the next one, or is merged with it.
+ * \param prev node before node (nullptr at the head).
+ */
+template <typename T, std::size_t K, typename Alloc>
+T UnrolledLinkedList<T, K, Alloc>::take(Node* prev, Node* node,
+                                        std::size_t offset) {
+  T output_(node->take(offset));
+  size_--;
+  Node* next = node->next();
+  if (node->count() == 0) {
+    unlink(prev, node);
+  } else if (node->count() < K / 2 && next != nullptr) {
+    if (node->count() + next->count() <= K) {
+      next->move_to(node, 0);
+      unlink(node, next);
+    } else {
+      node->emplace(node->count(), next->take(0));
+    }
+  }
+  return output_;
+}
+/**
+ * Unlinks and deletes an empty node.
+ * \param prev node before node (nullptr at the head).
+ */
+template <typename T, std::size_t K, typename Alloc>
+void UnrolledLinkedList<T, K, Alloc>::unlink(Node* prev, Node* node) {
+  if (prev == nullptr) {
+    head = node->next();
+  } else {
+    prev->next(node->next());
+  }
+  if (tail == node) {
+    tail = prev;
+  }
+  delete_node(node);
+}
+/**
+ * Finds the node holding the element at *index (which must be valid) and
+ * turns *index into the offset inside it.
+ */
+template <typename T, std::size_t K, typename Alloc>
+const typename UnrolledLinkedList<T, K, Alloc>::Node*
+UnrolledLinkedList<T, K, Alloc>::node_at(std::size_t* index) const {
+  if (*index >= size_ - tail->count()) {
+    *index -= size_ - tail->count();
+    return tail;
+  }
+  const Node* current = head;
+  while (*index >= current->count()) {
+    *index -= current->count();
+    current = current->next();
+  }
+  return current;
+}
+}  // namespace structures
+
+#endif
@@ -0,0 +1,440 @@
+// Copyright 2017 Eduardo Kohler
+
+#ifndef STRUCTURES_INTRUSIVE_CIRCULAR_LIST_H
+#define STRUCTURES_INTRUSIVE_CIRCULAR_LIST_H
+
+#include <cstddef>      // std::ptrdiff_t
+#include <cstdint>      // std::size_t
+#include <iterator>     // std::bidirectional_iterator_tag
+#include <stdexcept>    // C++ Exceptions
+#include <type_traits>  // std::conditional
+#include <utility>      // std::move, std::swap
+
+#include "./list_hook.h"
+
+namespace structures {
+/**
+ * Implementation of a template intrusive circular doubly linked list.
+ *
+ * Like IntrusiveList, elements are linked through their ListHook member
+ * and are never allocated, copied or destroyed by the list. The ring is
+ * exposed: next() and prev() wrap around, and rotate() moves the first
+ * element to the back in O(1), which is all a round-robin run queue needs.
+ * erase(data) unlinks in O(1) from a reference alone.
+ *
+ * Iterators run once around the ring, counting their steps as in
+ * DoublyCircularList.
+ */
+template <typename T, ListHook<T> T::*Member>
+class IntrusiveCircularList {
+ public:
+  template <bool Const>
+  class Iterator;
+  using iterator = Iterator<false>;
+  using const_iterator = Iterator<true>;
+
+  IntrusiveCircularList();
+  IntrusiveCircularList(const IntrusiveCircularList&) = delete;
+  IntrusiveCircularList(IntrusiveCircularList&& other);
+  IntrusiveCircularList& operator=(const IntrusiveCircularList&) = delete;
+  IntrusiveCircularList& operator=(IntrusiveCircularList&& other);
+  ~IntrusiveCircularList();
+
+  void clear();                             // desencadeia todos
+  void swap(IntrusiveCircularList& other);  // troca o conteúdo
+
+  void push_back(T& data);               // encadeia no fim
+  void push_front(T& data);              // encadeia no início
+  void insert_after(T& pos, T& data);    // encadeia após pos
+  T& pop_back();                         // desencadeia o último
+  T& pop_front();                        // desencadeia o primeiro
+  void erase(T& data);                   // desencadeia específico
+  void rotate();                         // primeiro passa a ser o último
+
+  bool empty() const;        // lista vazia
+  std::size_t size() const;  // tamanho
+
+  T& front();              // primeiro elemento
+  const T& front() const;  // primeiro elemento (const)
+  T& back();               // último elemento
+  const T& back() const;   // último elemento (const)
+  T& next(T& data);        // sucessor, dando a volta
+  T& prev(T& data);        // antecessor, dando a volta
+
+  iterator begin();               // primeiro elemento
+  const_iterator begin() const;   // primeiro elemento (const)
+  const_iterator cbegin() const;  // primeiro elemento (const)
+  iterator end();                 // após o último elemento
+  const_iterator end() const;     // após o último elemento (const)
+  const_iterator cend() const;    // após o último elemento (const)
+
+ private:
+  static ListHook<T>& hook(T& data) { return data.*Member; }
+
+  static const ListHook<T>& hook(const T& data) { return data.*Member; }
+
+  void link_before(T* next, T& data);
+  void unlink(T& data);
+  void check_linked(const T& data) const;
+
+  T* head{nullptr};
+  std::size_t size_{0u};
+};
+/**
+ * Bidirectional iterator over an IntrusiveCircularList. end() sits on
+ * head again, one lap later.
+ */
+template <typename T, ListHook<T> T::*Member>
+template <bool Const>
+class IntrusiveCircularList<T, Member>::Iterator {
+ public:
+  using iterator_category = std::bidirectional_iterator_tag;
+  using value_type = T;
+  using difference_type = std::ptrdiff_t;
+  using pointer = typename std::conditional<Const, const T*, T*>::type;
+  using reference = typename std::conditional<Const, const T&, T&>::type;
+
+  Iterator() = default;
+
+  template <bool C, typename = typename std::enable_if<Const && !C>::type>
+  Iterator(const Iterator<C>& other)  // NOLINT(runtime/explicit)
+      : node_{other.node_}, step_{other.step_} {}
+
+  reference operator*() const { return *node_; }
+
+  pointer operator->() const { return node_; }
+
+  Iterator& operator++() {
+    node_ = hook(*node_).next_;
+    step_++;
+    return *this;
+  }
+
+  Iterator operator++(int) {
+    Iterator old = *this;
+    ++*this;
+    return old;
+  }
+
+  Iterator& operator--() {
+    node_ = hook(*node_).prev_;
+    step_--;
+    return *this;
+  }
+
+  Iterator operator--(int) {
+    Iterator old = *this;
+    --*this;
+    return old;
+  }
+
+  bool operator==(const Iterator& other) const { return step_ == other.step_; }
+
+  bool operator!=(const Iterator& other) const { return step_ != other.step_; }
+
+ private:
+  friend class IntrusiveCircularList;
+  friend class Iterator<!Const>;
+
+  Iterator(T* node, std::size_t step) : node_{node}, step_{step} {}
+
+  T* node_{nullptr};
+  std::size_t step_{0u};
+};
+/**
+ * Constructor. Sets the attributes values.
+ */
+template <typename T, ListHook<T> T::*Member>
+IntrusiveCircularList<T, Member>::IntrusiveCircularList() {}
+/**
+ * Move constructor. Takes the elements of other, leaving it empty.
+ */
+template <typename T, ListHook<T> T::*Member>
+IntrusiveCircularList<T, Member>::IntrusiveCircularList(
+    IntrusiveCircularList&& other)
+    : head{other.head}, size_{other.size_} {
+  other.head = nullptr;
+  other.size_ = 0;
+}
+/**
+ * Move assignment. The previous elements are unlinked.
+ */
+template <typename T, ListHook<T> T::*Member>
+IntrusiveCircularList<T, Member>& IntrusiveCircularList<T, Member>::operator=(
+    IntrusiveCircularList&& other) {
+  IntrusiveCircularList moved(std::move(other));
+  swap(moved);
+  return *this;
+}
+/**
+ * Destructor. Unlinks every element.
+ */
+template <typename T, ListHook<T> T::*Member>
+IntrusiveCircularList<T, Member>::~IntrusiveCircularList() {
+  clear();
+}
+/**
+ * Clears the list, unlinking every element (they are not destroyed).
+ */
+template <typename T, ListHook<T> T::*Member>
+void IntrusiveCircularList<T, Member>::clear() {
+  T* current = head;
+  for (std::size_t i = 0; i < size_; i++) {
+    T* next = hook(*current).next_;
+    hook(*current).prev_ = nullptr;
+    hook(*current).next_ = nullptr;
+    current = next;
+  }
+  head = nullptr;
+  size_ = 0;
+}
+/**
+ * Exchanges the contents of two lists in O(1).
+ */
+template <typename T, ListHook<T> T::*Member>
+void IntrusiveCircularList<T, Member>::swap(IntrusiveCircularList& other) {
+  std::swap(head, other.head);
+  std::swap(size_, other.size_);
+}
+/**
+ * Links an element at the end of the list (right before head).
+ * \param data element, not yet in any list through this hook.
+ */
+template <typename T, ListHook<T> T::*Member>
+void IntrusiveCircularList<T, Member>::push_back(T& data) {
+  link_before(head, data);
+}
+/**
+ * Links an element at the front of the list.
+ * \param data element, not yet in any list through this hook.
+ */
+template <typename T, ListHook<T> T::*Member>
+void IntrusiveCircularList<T, Member>::push_front(T& data) {
+  link_before(head, data);
+  head = &data;
+}
+/**
+ * Links an element right after pos.
+ * \param pos element linked in this list;
+ * \param data element, not yet in any list through this hook.
+ */
+template <typename T, ListHook<T> T::*Member>
+void IntrusiveCircularList<T, Member>::insert_after(T& pos, T& data) {
+  check_linked(pos);
+  link_before(hook(pos).next_, data);
+}
+/**
+ * Unlinks the last element.
+ * \return the element that was unlinked.
+ */
+template <typename T, ListHook<T> T::*Member>
+T& IntrusiveCircularList<T, Member>::pop_back() {
+  T& popped = back();
+  unlink(popped);
+  return popped;
+}
+/**
+ * Unlinks the first element.
+ * \return the element that was unlinked.
+ */
+template <typename T, ListHook<T> T::*Member>
+T& IntrusiveCircularList<T, Member>::pop_front() {
+  T& popped = front();
+  unlink(popped);
+  return popped;
+}
+/**
+ * Unlinks an element of this list in O(1).
+ * \param data element linked in this list.
+ */
+template <typename T, ListHook<T> T::*Member>
+void IntrusiveCircularList<T, Member>::erase(T& data) {
+  check_linked(data);
+  unlink(data);
+}
+/**
+ * Moves the first element to the back by advancing head; no link changes.
+ */
+template <typename T, ListHook<T> T::*Member>
+void IntrusiveCircularList<T, Member>::rotate() {
+  if (empty()) {
+    throw std::out_of_range("Lista vazia");
+  }
+  head = hook(*head).next_;
+}
+/**
+ * Checks if the list is empty.
+ * \return boolean
+ */
+template <typename T, ListHook<T> T::*Member>
+bool IntrusiveCircularList<T, Member>::empty() const {
+  return size_ == 0;
+}
+/**
+ * Returns the list current size.
+ */
+template <typename T, ListHook<T> T::*Member>
+std::size_t IntrusiveCircularList<T, Member>::size() const {
+  return size_;
+}
+/**
+ * Returns a reference to the first element.
+ */
+template <typename T, ListHook<T> T::*Member>
+T& IntrusiveCircularList<T, Member>::front() {
+  if (empty()) {
+    throw std::out_of_range("Lista vazia");
+  }
+  return *head;
+}
+/**
+ * Returns a reference to the first element.
+ */
+template <typename T, ListHook<T> T::*Member>
+const T& IntrusiveCircularList<T, Member>::front() const {
+  if (empty()) {
+    throw std::out_of_range("Lista vazia");
+  }
+  return *head;
+}
+/**
+ * Returns a reference to the last element.
+ */
+template <typename T, ListHook<T> T::*Member>
+T& IntrusiveCircularList<T, Member>::back() {
+  if (empty()) {
+    throw std::out_of_range("Lista vazia");
+  }
+  return *hook(*head).prev_;
+}
+/**
+ * Returns a reference to the last element.
+ */
+template <typename T, ListHook<T> T::*Member>
+const T& IntrusiveCircularList<T, Member>::back() const {
+  if (empty()) {
+    throw std::out_of_range("Lista vazia");
+  }
+  return *hook(*head).prev_;
+}
+/**
+ * Returns the element after data; the last one is followed by the first.
+ * \param data element linked in this list.
+ */
+template <typename T, ListHook<T> T::*Member>
+T& IntrusiveCircularList<T, Member>::next(T& data) {
+  check_linked(data);
+  return *hook(data).next_;
+}
+/**
+ * Returns the element before data; the first one is preceded by the last.
+ * \param data element linked in this list.
+ */
+template <typename T, ListHook<T> T::*Member>
+T& IntrusiveCircularList<T, Member>::prev(T& data) {
+  check_linked(data);
+  return *hook(data).prev_;
+}
+/**
+ * Returns an iterator to the first element.
+ */
+template <typename T, ListHook<T> T::*Member>
+typename IntrusiveCircularList<T, Member>::iterator
+IntrusiveCircularList<T, Member>::begin() {
+  return iterator(head, 0);
+}
+/**
+ * Returns an iterator to the first element.
+ */
+template <typename T, ListHook<T> T::*Member>
+typename IntrusiveCircularList<T, Member>::const_iterator
+IntrusiveCircularList<T, Member>::begin() const {
+  return const_iterator(head, 0);
+}
+/**
+ * Returns an iterator to the first element.
+ */
+template <typename T, ListHook<T> T::*Member>
+typename IntrusiveCircularList<T, Member>::const_iterator
+IntrusiveCircularList<T, Member>::cbegin() const {
+  return begin();
+}
+/**
+ * Returns the past-the-end iterator (head, one lap later).
+ */
+template <typename T, ListHook<T> T::*Member>
+typename IntrusiveCircularList<T, Member>::iterator
+IntrusiveCircularList<T, Member>::end() {
+  return iterator(head, size_);
+}
+/**
+ * Returns the past-the-end iterator (head, one lap later).
+ */
+template <typename T, ListHook<T> T::*Member>
+typename IntrusiveCircularList<T, Member>::const_iterator
+IntrusiveCircularList<T, Member>::end() const {
+  return const_iterator(head, size_);
+}
+/**
+ * Returns the past-the-end iterator (head, one lap later).
+ */
+template <typename T, ListHook<T> T::*Member>
+typename IntrusiveCircularList<T, Member>::const_iterator
+IntrusiveCircularList<T, Member>::cend() const {
+  return end();
+}
+/**
+ * Links data into the ring right before next (nullptr only when the list
+ * is empty). head is left for the caller to move.
+ */
+template <typename T, ListHook<T> T::*Member>
+void IntrusiveCircularList<T, Member>::link_before(T* next, T& data) {
+  ListHook<T>& links = hook(data);
+  if (links.linked()) {
+    throw std::invalid_argument("Elemento já encadeado");
+  }
+  if (next == nullptr) {
+    links.prev_ = &data;
+    links.next_ = &data;
+    head = &data;
+  } else {
+    T* prev = hook(*next).prev_;
+    links.prev_ = prev;
+    links.next_ = next;
+    hook(*prev).next_ = &data;
+    hook(*next).prev_ = &data;
+  }
+  size_++;
+}
+/**
+ * Unlinks data from the ring and resets its hook.
+ */
+template <typename T, ListHook<T> T::*Member>
+void IntrusiveCircularList<T, Member>::unlink(T& data) {
+  ListHook<T>& links = hook(data);
+  if (size_ == 1) {
+    head = nullptr;
+  } else {
+    hook(*links.prev_).next_ = links.next_;
+    hook(*links.next_).prev_ = links.prev_;
+    if (head == &data) {
+      head = links.next_;
+    }
+  }
+  links.prev_ = nullptr;
+  links.next_ = nullptr;
+  size_--;
+}
+/**
+ * Elements given by reference must be linked through this hook; whether
+ * they are in this very list cannot be checked in O(1).
+ */
+template <typename T, ListHook<T> T::*Member>
+void IntrusiveCircularList<T, Member>::check_linked(const T& data) const {
+  if (!hook(data).linked()) {
+    throw std::invalid_argument("Elemento não encadeado");
+  }
+}
+}  // namespace structures
+
+#endif
@@ -0,0 +1,420 @@
+// Copyright 2017 Eduardo Kohler
+
+#ifndef STRUCTURES_INTRUSIVE_LIST_H
+#define STRUCTURES_INTRUSIVE_LIST_H
+
+#include <cstddef>      // std::ptrdiff_t
+#include <cstdint>      // std::size_t
+#include <iterator>     // std::bidirectional_iterator_tag
+#include <stdexcept>    // C++ Exceptions
+#include <type_traits>  // std::conditional
+#include <utility>      // std::move, std::swap
+
+#include "./list_hook.h"
+
+namespace structures {
+/**
+ * Implementation of a template intrusive doubly linked list.
+ *
+ * The list links elements it does not own through the ListHook member
+ * given as Member (e.g. IntrusiveList<Task, &Task::hook>), so it never
+ * allocates or copies. Elements must outlive their membership; clearing or
+ * destroying the list only unlinks them.
+ *
+ * Behind the interface the links form a ring (the last element's next is
+ * the first), which keeps both ends O(1) and lets a hook tell whether it
+ * is linked. erase(data) unlinks in O(1) from a reference alone; data must
+ * be in this list, which only the linked() check can catch.
+ */
+template <typename T, ListHook<T> T::*Member>
+class IntrusiveList {
+ public:
+  template <bool Const>
+  class Iterator;
+  using iterator = Iterator<false>;
+  using const_iterator = Iterator<true>;
+
+  IntrusiveList();
+  IntrusiveList(const IntrusiveList&) = delete;
+  IntrusiveList(IntrusiveList&& other);
+  IntrusiveList& operator=(const IntrusiveList&) = delete;
+  IntrusiveList& operator=(IntrusiveList&& other);
+  ~IntrusiveList();
+  void clear();
+  void swap(IntrusiveList& other);
+  void push_back(T& data);
+  void push_front(T& data);
+  iterator insert(const_iterator pos, T& data);
+  T& front();
+  const T& front() const;
+  T& back();
+  const T& back() const;
+  T& pop_back();
+  T& pop_front();
+  void erase(T& data);
+  iterator erase(const_iterator pos);
+  bool empty() const;
+  std::size_t size() const;
+
+  iterator begin();
+  const_iterator begin() const;
+  const_iterator cbegin() const;
+  iterator end();
+  const_iterator end() const;
+  const_iterator cend() const;
+
+ private:
+  static ListHook<T>& hook(T& data) { return data.*Member; }
+
+  static const ListHook<T>& hook(const T& data) { return data.*Member; }
+
+  void link_before(T* next, T& data);
+  void unlink(T& data);
+
+  T* head{nullptr};
+  std::size_t size_{0u};
+};
+/**
+ * Bidirectional iterator over an IntrusiveList. end() holds no element;
+ * stepping back from it reaches the last one.
+ */
+template <typename T, ListHook<T> T::*Member>
+template <bool Const>
+class IntrusiveList<T, Member>::Iterator {
+ public:
+  using iterator_category = std::bidirectional_iterator_tag;
+  using value_type = T;
+  using difference_type = std::ptrdiff_t;
+  using pointer = typename std::conditional<Const, const T*, T*>::type;
+  using reference = typename std::conditional<Const, const T&, T&>::type;
+
+  Iterator() = default;
+
+  template <bool C, typename = typename std::enable_if<Const && !C>::type>
+  Iterator(const Iterator<C>& other)  // NOLINT(runtime/explicit)
+      : node_{other.node_}, list_{other.list_} {}
+
+  reference operator*() const { return *node_; }
+
+  pointer operator->() const { return node_; }
+
+  Iterator& operator++() {
+    node_ = hook(*node_).next_;
+    if (node_ == list_->head) {
+      node_ = nullptr;
+    }
+    return *this;
+  }
+
+  Iterator operator++(int) {
+    Iterator old = *this;
+    ++*this;
+    return old;
+  }
+
+  Iterator& operator--() {
+    node_ = hook(node_ == nullptr ? *list_->head : *node_).prev_;
+    return *this;
+  }
+
+  Iterator operator--(int) {
+    Iterator old = *this;
+    --*this;
+    return old;
+  }
+
+  bool operator==(const Iterator& other) const { return node_ == other.node_; }
+
+  bool operator!=(const Iterator& other) const { return node_ != other.node_; }
+
+ private:
+  friend class IntrusiveList;
+  friend class Iterator<!Const>;
+
+  Iterator(T* node, const IntrusiveList* list) : node_{node}, list_{list} {}
+
+  T* node_{nullptr};
+  const IntrusiveList* list_{nullptr};
+};
+/**
+ * Constructor. Sets the attributes values.
+ */
+template <typename T, ListHook<T> T::*Member>
+IntrusiveList<T, Member>::IntrusiveList() {}
+/**
+ * Move constructor. Takes the elements of other, leaving it empty. The
+ * elements link to each other, not to the list, so nothing else changes.
+ */
+template <typename T, ListHook<T> T::*Member>
+IntrusiveList<T, Member>::IntrusiveList(IntrusiveList&& other)
+    : head{other.head}, size_{other.size_} {
+  other.head = nullptr;
+  other.size_ = 0;
+}
+/**
+ * Move assignment. The previous elements are unlinked.
+ */
+template <typename T, ListHook<T> T::*Member>
+IntrusiveList<T, Member>& IntrusiveList<T, Member>::operator=(
+    IntrusiveList&& other) {
+  IntrusiveList moved(std::move(other));
+  swap(moved);
+  return *this;
+}
+/**
+ * Destructor. Unlinks every element.
+ */
+template <typename T, ListHook<T> T::*Member>
+IntrusiveList<T, Member>::~IntrusiveList() {
+  clear();
+}
+/**
+ * Clears the list, unlinking every element (they are not destroyed).
+ */
+template <typename T, ListHook<T> T::*Member>
+void IntrusiveList<T, Member>::clear() {
+  T* current = head;
+  for (std::size_t i = 0; i < size_; i++) {
+    T* next = hook(*current).next_;
+    hook(*current).prev_ = nullptr;
+    hook(*current).next_ = nullptr;
+    current = next;
+  }
+  head = nullptr;
+  size_ = 0;
+}
+/**
+ * Exchanges the contents of two lists in O(1).
+ */
+template <typename T, ListHook<T> T::*Member>
+void IntrusiveList<T, Member>::swap(IntrusiveList& other) {
+  std::swap(head, other.head);
+  std::swap(size_, other.size_);
+}
+/**
+ * Links an element at the end of the list.
+ * \param data element, not yet in any list through this hook.
+ */
+template <typename T, ListHook<T> T::*Member>
+void IntrusiveList<T, Member>::push_back(T& data) {
+  link_before(head, data);
+}
+/**
+ * Links an element at the front of the list.
+ * \param data element, not yet in any list through this hook.
+ */
+template <typename T, ListHook<T> T::*Member>
+void IntrusiveList<T, Member>::push_front(T& data) {
+  link_before(head, data);
+  head = &data;
+}
+/**
+ * Links an element before pos.
+ * \param pos position in this list (end() appends);
+ * \param data element, not yet in any list through this hook.
+ * \return iterator to data.
+ */
+template <typename T, ListHook<T> T::*Member>
+typename IntrusiveList<T, Member>::iterator
+IntrusiveList<T, Member>::insert(const_iterator pos, T& data) {
+  link_before(pos.node_ == nullptr ? head : pos.node_, data);
+  if (pos.node_ == head && pos.node_ != nullptr) {
+    head = &data;
+  }
+  return iterator(&data, this);
+}
+/**
+ * Returns a reference to the first element.
+ */
+template <typename T, ListHook<T> T::*Member>
+T& IntrusiveList<T, Member>::front() {
+  if (empty()) {
+    throw std::out_of_range("Lista vazia");
+  }
+  return *head;
+}
+/**
+ * Returns a reference to the first element.
+ */
+template <typename T, ListHook<T> T::*Member>
+const T& IntrusiveList<T, Member>::front() const {
+  if (empty()) {
+    throw std::out_of_range("Lista vazia");
+  }
+  return *head;
+}
+/**
+ * Returns a reference to the last element.
+ */
+template <typename T, ListHook<T> T::*Member>
+T& IntrusiveList<T, Member>::back() {
+  if (empty()) {
+    throw std::out_of_range("Lista vazia");
+  }
+  return *hook(*head).prev_;
+}
+/**
+ * Returns a reference to the last element.
+ */
+template <typename T, ListHook<T> T::*Member>
+const T& IntrusiveList<T, Member>::back() const {
+  if (empty()) {
+    throw std::out_of_range("Lista vazia");
+  }
+  return *hook(*head).prev_;
+}
+/**
+ * Unlinks the last element.
+ * \return the element that was unlinked.
+ */
+template <typename T, ListHook<T> T::*Member>
+T& IntrusiveList<T, Member>::pop_back() {
+  T& popped = back();
+  unlink(popped);
+  return popped;
+}
+/**
+ * Unlinks the first element.
+ * \return the element that was unlinked.
+ */
+template <typename T, ListHook<T> T::*Member>
+T& IntrusiveList<T, Member>::pop_front() {
+  T& popped = front();
+  unlink(popped);
+  return popped;
+}
+/**
+ * Unlinks an element of this list in O(1).
+ * \param data element linked in this list.
+ */
+template <typename T, ListHook<T> T::*Member>
+void IntrusiveList<T, Member>::erase(T& data) {
+  if (!hook(data).linked()) {
+    throw std::invalid_argument("Elemento não encadeado");
+  }
+  unlink(data);
+}
+/**
+ * Unlinks the element at pos.
+ * \param pos dereferenceable iterator.
+ * \return iterator to the element that followed it.
+ */
+template <typename T, ListHook<T> T::*Member>
+typename IntrusiveList<T, Member>::iterator
+IntrusiveList<T, Member>::erase(const_iterator pos) {
+  if (pos.node_ == nullptr) {
+    throw std::out_of_range("Index inválido");
+  }
+  iterator next(pos.node_, this);
+  ++next;
+  unlink(*pos.node_);
+  return next;
+}
+/**
+ * Checks if the list is empty.
+ * \return boolean
+ */
+template <typename T, ListHook<T> T::*Member>
+bool IntrusiveList<T, Member>::empty() const {
+  return size_ == 0;
+}
+/**
+ * Returns the list current size.
+ */
+template <typename T, ListHook<T> T::*Member>
+std::size_t IntrusiveList<T, Member>::size() const {
+  return size_;
+}
+/**
+ * Returns an iterator to the first element.
+ */
+template <typename T, ListHook<T> T::*Member>
+typename IntrusiveList<T, Member>::iterator
+IntrusiveList<T, Member>::begin() {
+  return iterator(head, this);
+}
+/**
+ * Returns an iterator to the first element.
+ */
+template <typename T, ListHook<T> T::*Member>
+typename IntrusiveList<T, Member>::const_iterator
+IntrusiveList<T, Member>::begin() const {
+  return const_iterator(head, this);
+}
+/**
+ * Returns an iterator to the first element.
+ */
+template <typename T, ListHook<T> T::*Member>
+typename IntrusiveList<T, Member>::const_iterator
+IntrusiveList<T, Member>::cbegin() const {
+  return begin();
+}
+/**
+ * Returns the past-the-end iterator.
+ */
+template <typename T, ListHook<T> T::*Member>
+typename IntrusiveList<T, Member>::iterator
+IntrusiveList<T, Member>::end() {
+  return iterator(nullptr, this);
+}
+/**
+ * Returns the past-the-end iterator.
+ */
+template <typename T, ListHook<T> T::*Member>
+typename IntrusiveList<T, Member>::const_iterator
+IntrusiveList<T, Member>::end() const {
+  return const_iterator(nullptr, this);
+}
+/**
+ * Returns the past-the-end iterator.
+ */
+template <typename T, ListHook<T> T::*Member>
+typename IntrusiveList<T, Member>::const_iterator
+IntrusiveList<T, Member>::cend() const {
+  return end();
+}
+/**
+ * Links data into the ring right before next (which may be nullptr only
+ * when the list is empty). head is left for the caller to move.
+ */
+template <typename T, ListHook<T> T::*Member>
+void IntrusiveList<T, Member>::link_before(T* next, T& data) {
+  ListHook<T>& links = hook(data);
+  if (links.linked()) {
+    throw std::invalid_argument("Elemento já encadeado");
+  }
+  if (next == nullptr) {
+    links.prev_ = &data;
+    links.next_ = &data;
+    head = &data;
+  } else {
+    T* prev = hook(*next).prev_;
+    links.prev_ = prev;
+    links.next_ = next;
+    hook(*prev).next_ = &data;
+    hook(*next).prev_ = &data;
+  }
+  size_++;
+}
+/**
+ * Unlinks data from the ring and resets its hook.
+ */
+template <typename T, ListHook<T> T::*Member>
+void IntrusiveList<T, Member>::unlink(T& data) {
+  ListHook<T>& links = hook(data);
+  if (size_ == 1) {
+    head = nullptr;
+  } else {
+    hook(*links.prev_).next_ = links.next_;
+    hook(*links.next_).prev_ = links.prev_;
+    if (head == &data) {
+      head = links.next_;
+    }
+  }
+  links.prev_ = nullptr;
+  links.next_ = nullptr;
+  size_--;
+}
+}  // namespace structures
+
+#endif
@@ -0,0 +1,52 @@
+// Copyright 2017 Eduardo Kohler
+
+#ifndef STRUCTURES_LIST_HOOK_H
+#define STRUCTURES_LIST_HOOK_H
+
+namespace structures {
+template <typename T>
+class ListHook;
+
+template <typename T, ListHook<T> T::*Member>
+class IntrusiveList;
+
+template <typename T, ListHook<T> T::*Member>
+class IntrusiveCircularList;
+
+/**
+ * Links embedded in an element so that intrusive lists can hold it without
+ * a node of their own.
+ *
+ * A type that should sit in several lists at once declares one hook per
+ * list, and each list is told which member to use. The links point to the
+ * neighbouring elements themselves. Copying an element does not copy its
+ * membership: a copied hook starts unlinked, and assigning to a hook leaves
+ * it as it was.
+ */
+template <typename T>
+class ListHook {
+ public:
+  ListHook() = default;
+
+  ListHook(const ListHook&) {}
+
+  ListHook& operator=(const ListHook&) { return *this; }
+
+  /**
+   * Whether the element is in a list through this hook.
+   */
+  bool linked() const { return next_ != nullptr; }
+
+ private:
+  template <typename U, ListHook<U> U::*Member>
+  friend class IntrusiveList;
+
+  template <typename U, ListHook<U> U::*Member>
+  friend class IntrusiveCircularList;
+
+  T* prev_{nullptr};
+  T* next_{nullptr};
+};
+}  // namespace structures
+
+#endif
@@ -0,0 +1,220 @@
+// Copyright 2017 Eduardo Kohler
+
+#ifndef STRUCTURES_NODE_POOL_H
+#define STRUCTURES_NODE_POOL_H
+
+#include <cstddef>      // std::max_align_t
+#include <cstdint>      // std::size_t
+#include <memory>       // std::shared_ptr
+#include <new>          // ::operator new
+#include <type_traits>  // std::true_type
+
+namespace structures {
+/**
+ * Pool de nodos de tamanho fixo.
+ *
+ * A memória vem em blocos do tamanho de uma página, divididos em posições do
+ * tamanho de um nodo. Posições devolvidas formam uma lista livre intrusiva
+ * (o próprio espaço do nodo guarda o ponteiro para a próxima), então alocar
+ * e liberar custam algumas instruções. release() devolve todos os blocos de
+ * uma vez.
+ */
+class NodePool {
+ public:
+  static const std::size_t BLOCK_SIZE = 4096;  // tamanho de um bloco
+
+  NodePool() = default;
+
+  NodePool(const NodePool&) = delete;
+
+  NodePool& operator=(const NodePool&) = delete;
+
+  ~NodePool() { release(); }
+
+  /**
+   * Verifica se o pool serve objetos deste tamanho. A primeira consulta
+   * fixa o tamanho das posições.
+   */
+  bool accepts(std::size_t size, std::size_t align) {
+    if (align > alignof(std::max_align_t)) {
+      return false;
+    }
+    if (align < alignof(FreeSlot)) {
+      align = alignof(FreeSlot);
+    }
+    if (size < sizeof(FreeSlot)) {
+      size = sizeof(FreeSlot);
+    }
+    size = (size + align - 1) / align * align;
+    if (slot_size_ == 0) {
+      slot_size_ = size;
+    }
+    return slot_size_ == size;
+  }
+
+  /**
+   * Retorna uma posição livre, criando um bloco novo se preciso.
+   */
+  void* allocate() {
+    if (free_ != nullptr) {
+      FreeSlot* slot = free_;
+      free_ = slot->next;
+      return slot;
+    }
+    if (cursor_ == limit_) {
+      grow();
+    }
+    void* slot = cursor_;
+    cursor_ += slot_size_;
+    return slot;
+  }
+
+  /**
+   * Devolve uma posição para a lista livre.
+   */
+  void deallocate(void* pointer) {
+    FreeSlot* slot = static_cast<FreeSlot*>(pointer);
+    slot->next = free_;
+    free_ = slot;
+  }
+
+  /**
+   * Devolve todos os blocos de uma vez. Qualquer posição ainda em uso passa
+   * a ser inválida.
+   */
+  void release() {
+    while (blocks_ != nullptr) {
+      Block* next = blocks_->next;
+      ::operator delete(blocks_);
+      blocks_ = next;
+    }
+    free_ = nullptr;
+    cursor_ = nullptr;
+    limit_ = nullptr;
+  }
+
+ private:
+  struct Block {
+    Block* next;
+  };
+
+  struct FreeSlot {
+    FreeSlot* next;
+  };
+
+  static const std::size_t HEADER_SIZE =
+      (sizeof(Block) + alignof(std::max_align_t) - 1) /
+      alignof(std::max_align_t) * alignof(std::max_align_t);
+
+  /**
+   * Aloca um bloco novo; as posições são entregues por cursor_ sob demanda.
+   */
+  void grow() {
+    std::size_t slots = (BLOCK_SIZE - HEADER_SIZE) / slot_size_;
+    if (slots == 0) {
+      slots = 1;
+    }
+    char* memory =
+        static_cast<char*>(::operator new(HEADER_SIZE + slots * slot_size_));
+    Block* block = reinterpret_cast<Block*>(memory);
+    block->next = blocks_;
+    blocks_ = block;
+    cursor_ = memory + HEADER_SIZE;
+    limit_ = cursor_ + slots * slot_size_;
+  }
+
+  std::size_t slot_size_{0};   // tamanho de cada posição
+  Block* blocks_{nullptr};     // blocos alocados
+  char* cursor_{nullptr};      // próxima posição nunca usada do bloco atual
+  char* limit_{nullptr};       // fim do bloco atual
+  FreeSlot* free_{nullptr};    // posições devolvidas
+};
+
+/**
+ * Alocador para os contêineres encadeados que usa um NodePool.
+ *
+ * Cópias e rebinds compartilham o mesmo pool. Cada contêiner construído do
+ * zero (ou copiado de outro) recebe um pool próprio, então clear() pode
+ * liberar todos os nodos de uma vez com BulkRelease. Pedidos de mais de um
+ * objeto, ou de um tamanho diferente do que fixou o pool, vão direto para
+ * ::operator new.
+ */
+template <typename T>
+class PoolAllocator {
+ public:
+  using value_type = T;
+  using propagate_on_container_copy_assignment = std::false_type;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap = std::true_type;
+
+  PoolAllocator() : pool_{std::make_shared<NodePool>()} {}
+
+  // Sem construtor de movimento: mover copia, e o pool nunca fica nulo.
+  PoolAllocator(const PoolAllocator& other) = default;
+
+  template <typename U>
+  PoolAllocator(const PoolAllocator<U>& other) : pool_{other.pool_} {}
+
+  T* allocate(std::size_t n) {
+    if (n == 1 && pool_->accepts(sizeof(T), alignof(T))) {
+      return static_cast<T*>(pool_->allocate());
+    }
+    return static_cast<T*>(::operator new(n * sizeof(T)));
+  }
+
+  void deallocate(T* pointer, std::size_t n) {
+    if (n == 1 && pool_->accepts(sizeof(T), alignof(T))) {
+      pool_->deallocate(pointer);
+    } else {
+      ::operator delete(pointer);
+    }
+  }
+
+  PoolAllocator select_on_container_copy_construction() const {
+    return PoolAllocator();
+  }
+
+  /**
+   * Só é seguro liberar tudo quando nenhum outro alocador usa o pool.
+   */
+  bool releasable() const { return pool_.use_count() == 1; }
+
+  void release() { pool_->release(); }
+
+  template <typename U>
+  bool operator==(const PoolAllocator<U>& other) const {
+    return pool_ == other.pool_;
+  }
+
+  template <typename U>
+  bool operator!=(const PoolAllocator<U>& other) const {
+    return pool_ != other.pool_;
+  }
+
+ private:
+  template <typename U>
+  friend class PoolAllocator;
+
+  std::shared_ptr<NodePool> pool_;
+};
+
+/**
+ * Liberação em bloco dos nodos de um contêiner. Para alocadores comuns não
+ * está disponível e clear() devolve nodo por nodo.
+ */
+template <typename Alloc>
+struct BulkRelease {
+  static bool available(const Alloc&) { return false; }
+  static void release(Alloc&) {}
+};
+
+template <typename T>
+struct BulkRelease<PoolAllocator<T>> {
+  static bool available(const PoolAllocator<T>& alloc) {
+    return alloc.releasable();
+  }
+  static void release(PoolAllocator<T>& alloc) { alloc.release(); }
+};
+}  // namespace structures
+
+#endif
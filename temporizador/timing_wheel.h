@@ -0,0 +1,309 @@
+// Copyright 2017 Eduardo Kohler
+
+#ifndef STRUCTURES_TIMING_WHEEL_H
+#define STRUCTURES_TIMING_WHEEL_H
+
+#include <cstdint>      // std::size_t, std::uint32_t, std::uint64_t
+#include <deque>        // std::deque
+#include <new>          // placement new
+#include <type_traits>  // std::aligned_storage
+#include <utility>      // std::forward, std::move
+#include <vector>       // std::vector
+
+#include "../listaintrusiva/intrusive_circular_list.h"
+
+namespace structures {
+/**
+ * Implementation of a template hierarchical hashed timing wheel.
+ *
+ * Time advances in ticks. There are LEVELS wheels of SLOTS buckets; level
+ * l covers SLOTS^(l+1) ticks, with each bucket spanning SLOTS^l of them. A
+ * timer is hashed into the lowest level whose current span holds its
+ * expiry. When level 0 completes a turn, the current bucket of level 1 is
+ * cascaded (its timers are placed again, now in level 0), and so on up,
+ * which costs O(1) amortized per timer and level. Timers beyond the top
+ * level wait in an overflow bucket.
+ *
+ * Every bucket is an IntrusiveCircularList (modeled on
+ * DoublyCircularList) threaded through the timer records, so arming, and
+ * cancelling through the returned Handle, are O(1). A tick visits only
+ * the bucket that expires. Records are recycled; a handle carries the
+ * generation of its record, so a stale one is simply ignored.
+ */
+template <typename T>
+class TimingWheel {
+ public:
+  static const std::size_t SLOT_BITS = 8;
+  static const std::size_t SLOTS = std::size_t{1} << SLOT_BITS;
+  static const std::size_t LEVELS = 4;  // 2^32 ticks before the overflow
+
+  /**
+   * Identifies an armed timer. A default handle matches no timer.
+   */
+  struct Handle {
+    std::uint32_t index{0u};
+    std::uint32_t generation{0u};
+  };
+
+  TimingWheel();
+  TimingWheel(const TimingWheel&) = delete;
+  TimingWheel& operator=(const TimingWheel&) = delete;
+  ~TimingWheel();
+
+  Handle arm(const T& data, std::uint64_t delay);
+  Handle arm(T&& data, std::uint64_t delay);
+  bool cancel(Handle handle);
+  bool armed(Handle handle) const;
+  template <typename Expire>
+  std::size_t tick(Expire&& expire);
+  template <typename Expire>
+  std::size_t advance(std::uint64_t ticks, Expire&& expire);
+  void clear();
+  std::uint64_t now() const;
+  bool empty() const;
+  std::size_t size() const;
+
+ private:
+  struct Record {
+    T& data() { return *reinterpret_cast<T*>(&storage); }
+
+    ListHook<Record> hook;
+    std::uint64_t expires{0u};
+    std::uint32_t index{0u};
+    std::uint32_t generation{1u};
+    bool active{false};
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+  };
+
+  using Bucket = IntrusiveCircularList<Record, &Record::hook>;
+
+  template <typename U>
+  Handle emplace(U&& data, std::uint64_t delay);
+  void place(Record& record);
+  Bucket& bucket_of(std::uint64_t expires);
+  void cascade(Bucket& bucket);
+  void release(Record& record);
+
+  Bucket wheels_[LEVELS][SLOTS];
+  Bucket overflow_;                  // beyond the top level
+  std::deque<Record> records_;       // stable addresses for the hooks
+  std::vector<std::uint32_t> free_;  // indexes of unused records
+  std::uint64_t now_{0u};
+  std::size_t size_{0u};
+};
+/**
+ * Constructor. The wheel starts at tick 0.
+ */
+template <typename T>
+TimingWheel<T>::TimingWheel() {}
+/**
+ * Destructor. Pending timers are dropped without expiring.
+ */
+template <typename T>
+TimingWheel<T>::~TimingWheel() {
+  clear();
+}
+/**
+ * Arms a timer that expires delay ticks from now (at least one).
+ * \param data data handed to the expire function;
+ * \param delay number of ticks.
+ * \return handle to cancel the timer.
+ */
+template <typename T>
+typename TimingWheel<T>::Handle TimingWheel<T>::arm(const T& data,
+                                                    std::uint64_t delay) {
+  return emplace(data, delay);
+}
+/**
+ * Arms a timer, moving its data in.
+ */
+template <typename T>
+typename TimingWheel<T>::Handle TimingWheel<T>::arm(T&& data,
+                                                    std::uint64_t delay) {
+  return emplace(std::move(data), delay);
+}
+/**
+ * Cancels a pending timer in O(1); its data is destroyed.
+ * \return false if the timer already expired or was cancelled.
+ */
+template <typename T>
+bool TimingWheel<T>::cancel(Handle handle) {
+  if (!armed(handle)) {
+    return false;
+  }
+  Record& record = records_[handle.index];
+  bucket_of(record.expires).erase(record);
+  release(record);
+  return true;
+}
+/**
+ * Checks if a handle refers to a pending timer.
+ * \return boolean
+ */
+template <typename T>
+bool TimingWheel<T>::armed(Handle handle) const {
+  return handle.index < records_.size() &&
+         records_[handle.index].generation == handle.generation &&
+         records_[handle.index].active;
+}
+/**
+ * Advances one tick, cascading the upper levels when a turn completes,
+ * and expires the timers of the new current bucket.
+ * \param expire called as expire(T&) for each expired timer; it may arm
+ * and cancel timers.
+ * \return number of expired timers.
+ */
+template <typename T>
+template <typename Expire>
+std::size_t TimingWheel<T>::tick(Expire&& expire) {
+  now_++;
+  for (std::size_t level = 1; level <= LEVELS; level++) {
+    std::size_t shift = SLOT_BITS * level;
+    if ((now_ & ((std::uint64_t{1} << shift) - 1)) != 0) {
+      break;
+    }
+    if (level == LEVELS) {
+      cascade(overflow_);
+    } else {
+      cascade(wheels_[level][(now_ >> shift) & (SLOTS - 1)]);
+    }
+  }
+  Bucket& bucket = wheels_[0][now_ & (SLOTS - 1)];
+  std::size_t expired = 0;
+  while (!bucket.empty()) {
+    Record& record = bucket.pop_front();
+    T data(std::move(record.data()));
+    release(record);
+    expired++;
+    expire(data);
+  }
+  return expired;
+}
+/**
+ * Advances several ticks, one at a time.
+ * \return number of expired timers.
+ */
+template <typename T>
+template <typename Expire>
+std::size_t TimingWheel<T>::advance(std::uint64_t ticks,
+                                    Expire&& expire) {
+  std::size_t expired = 0;
+  for (std::uint64_t i = 0; i < ticks; i++) {
+    expired += tick(expire);
+  }
+  return expired;
+}
+/**
+ * Drops every pending timer without expiring it. The time is kept.
+ */
+template <typename T>
+void TimingWheel<T>::clear() {
+  for (auto& level : wheels_) {
+    for (auto& bucket : level) {
+      bucket.clear();
+    }
+  }
+  overflow_.clear();
+  for (auto& record : records_) {
+    if (record.active) {
+      release(record);
+    }
+  }
+}
+/**
+ * Returns the current tick.
+ */
+template <typename T>
+std::uint64_t TimingWheel<T>::now() const {
+  return now_;
+}
+/**
+ * Checks if no timer is pending.
+ * \return boolean
+ */
+template <typename T>
+bool TimingWheel<T>::empty() const {
+  return size_ == 0;
+}
+/**
+ * Returns the number of pending timers.
+ */
+template <typename T>
+std::size_t TimingWheel<T>::size() const {
+  return size_;
+}
+/**
+ * Takes a record (a recycled one if possible), builds the data in it and
+ * places it.
+ */
+template <typename T>
+template <typename U>
+typename TimingWheel<T>::Handle TimingWheel<T>::emplace(
+    U&& data, std::uint64_t delay) {
+  if (free_.empty()) {
+    records_.emplace_back();
+    records_.back().index = static_cast<std::uint32_t>(records_.size() - 1);
+    free_.push_back(records_.back().index);
+  }
+  Record& record = records_[free_.back()];
+  new (&record.storage) T(std::forward<U>(data));
+  free_.pop_back();
+  record.active = true;
+  record.expires = now_ + (delay == 0 ? 1 : delay);
+  place(record);
+  size_++;
+  Handle handle;
+  handle.index = record.index;
+  handle.generation = record.generation;
+  return handle;
+}
+/**
+ * Links a record into the bucket for its expiry.
+ */
+template <typename T>
+void TimingWheel<T>::place(Record& record) {
+  bucket_of(record.expires).push_back(record);
+}
+/**
+ * Returns the bucket for an expiry: the lowest level whose current span
+ * (the ticks sharing now's upper bits) holds it. Cascades keep a pending
+ * timer in exactly this bucket as time advances, so cancel can find it
+ * again the same way.
+ */
+template <typename T>
+typename TimingWheel<T>::Bucket& TimingWheel<T>::bucket_of(
+    std::uint64_t expires) {
+  std::uint64_t distance = expires ^ now_;
+  for (std::size_t level = 0; level < LEVELS; level++) {
+    if ((distance >> (SLOT_BITS * (level + 1))) == 0) {
+      return wheels_[level][(expires >> (SLOT_BITS * level)) & (SLOTS - 1)];
+    }
+  }
+  return overflow_;
+}
+/**
+ * Places again every timer of a bucket whose span has just started; they
+ * all land in lower levels (or stay in the overflow).
+ */
+template <typename T>
+void TimingWheel<T>::cascade(Bucket& bucket) {
+  Bucket pending(std::move(bucket));
+  while (!pending.empty()) {
+    place(pending.pop_front());
+  }
+}
+/**
+ * Destroys the data of a record and puts it back in the free list. The
+ * generation changes, so handles to it no longer match.
+ */
+template <typename T>
+void TimingWheel<T>::release(Record& record) {
+  record.data().~T();
+  record.active = false;
+  record.generation++;
+  free_.push_back(record.index);
+  size_--;
+}
+}  // namespace structures
+
+#endif